@@ -0,0 +1,225 @@
+/**************************************************************************/
+/*  core_benchmark.cpp                                                    */
+/*  Microbenchmarks of the Godot-free core library.                       */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "core/border.hpp"
+#include "core/hit_test.hpp"
+#include "core/item_texts.hpp"
+#include "core/region.hpp"
+#include "core/right_click_drag.hpp"
+#include "core/search_index.hpp"
+#include "core/style.hpp"
+#include "core/window_registry.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Prints one JSON object per line:
+// {"name":"adjust_colors","iterations":1000000,"ns_per_op":3.125}
+//
+// Usage: core-benchmark [iterations]
+
+namespace {
+	// Keeps the optimizer from removing the benchmarked code.
+	volatile int64_t sink;
+
+	template <typename F>
+	void run(const char* name, int64_t iterations, F&& body) {
+		// Warm up.
+		for (int64_t i = 0; i < iterations / 10; i++)
+			sink = sink + body(i);
+
+		auto start = std::chrono::steady_clock::now();
+		for (int64_t i = 0; i < iterations; i++)
+			sink = sink + body(i);
+		auto end = std::chrono::steady_clock::now();
+
+		double ns = std::chrono::duration<double, std::nano>(end - start).count();
+		printf("{\"name\":\"%s\",\"iterations\":%lld,\"ns_per_op\":%.3f}\n",
+			name, static_cast<long long>(iterations), ns / iterations);
+	}
+}
+
+int main(int argc, char** argv) {
+	using namespace acrylic;
+
+	int64_t iterations = 10000000;
+	if (argc > 1)
+		iterations = std::atoll(argv[1]);
+
+	if (iterations <= 0) {
+		fprintf(stderr, "Invalid number of iterations: %s.\n", argv[1]);
+		return 1;
+	}
+
+	run("adjust_colors", iterations, [](int64_t i) {
+		float value = (i & 255) / 255.0f;
+		StyleColors colors = adjust_colors(Rgba(value, 1 - value, 0.5f, value));
+		return static_cast<int64_t>(colors.text_color.r + colors.clear_color.g);
+	});
+
+	run("get_dwm_backdrop_type", iterations, [](int64_t i) {
+		return static_cast<int64_t>(get_dwm_backdrop_type(static_cast<Backdrop>(i % 5)));
+	});
+
+	run("get_dwm_corner_preference", iterations, [](int64_t i) {
+		return static_cast<int64_t>(get_dwm_corner_preference(static_cast<Corner>(i & 3)));
+	});
+
+	run("get_window_border", iterations, [](int64_t i) {
+		Border border = get_window_border({ -8, -31, 8, 8 }, (i & 1) != 0);
+		return static_cast<int64_t>(border.top);
+	});
+
+	run("get_border_metrics", iterations, [](int64_t i) {
+		BorderMetrics metrics = get_border_metrics({ -8, -8, 8, 8 }, { -8, -31, 8, 8 }, (i & 1) != 0);
+		return static_cast<int64_t>(metrics.border.top + metrics.caption_top);
+	});
+
+	// What WM_NCHITTEST pays between style and DPI changes.
+	run("border_metrics_cache_get", iterations, [](int64_t i) {
+		static BorderMetricsCache cache;
+		if (!cache.is_valid())
+			cache.store({ -8, -8, 8, 8 }, { -8, -31, 8, 8 });
+
+		BorderMetrics metrics = cache.get((i & 1) != 0);
+		return static_cast<int64_t>(metrics.border.top + metrics.caption_top);
+	});
+
+	run("calculate_client_rect", iterations, [](int64_t i) {
+		Rect client_rect = { 0, 0, 1920, 1080 };
+		calculate_client_rect(static_cast<Frame>(i % 3), { -6, -8, 8, 8 }, &client_rect);
+		return static_cast<int64_t>(client_rect.top + client_rect.right);
+	});
+
+	run("get_hit_zone", iterations, [](int64_t i) {
+		int32_t client_y = static_cast<int32_t>(i & 63) - 16;
+		return static_cast<int64_t>(get_hit_zone(client_y, DEFAULT_HITTEST_BORDER, (i & 64) != 0, -31));
+	});
+
+	run("right_click_drag", iterations, [](int64_t i) {
+		static RightClickDrag drag;
+		if ((i & 31) == 0)
+			drag.press({ 0, 0 });
+
+		Point delta;
+		int32_t step = static_cast<int32_t>(i & 31);
+		return static_cast<int64_t>(drag.move({ step, step / 2 }, &delta));
+	});
+
+	// The cost of finding the per-window state of a message must not grow with the number of windows.
+	for (int window_count : { 1, 10, 50, 1000 }) {
+		WindowRegistry<RightClickDrag> registry;
+		for (int i = 0; i < window_count; i++) {
+			// Handles look like pointers.
+			registry.insert(0x10000 + static_cast<uint64_t>(i) * 0x40, RightClickDrag());
+		}
+
+		std::string name = "window_registry_find/" + std::to_string(window_count);
+		run(name.c_str(), iterations, [&registry, window_count](int64_t i) {
+			uint64_t key = 0x10000 + static_cast<uint64_t>(i % window_count) * 0x40;
+			return static_cast<int64_t>(registry.find(key)->is_pressed());
+		});
+	}
+
+	// Opaque and blur regions of a window with a sidebar, a toolbar and a few cards.
+	{
+		const std::vector<Rect> panels = {
+			{ 0, 0, 240, 1080 },
+			{ 240, 0, 1920, 48 },
+			{ 280, 88, 880, 488 },
+			{ 920, 88, 1520, 488 },
+			{ 280, 528, 880, 928 },
+			{ 860, 528, 1520, 928 }
+		};
+
+		run("merge_rects/6", iterations / 100, [&panels](int64_t) {
+			return static_cast<int64_t>(merge_rects(panels).size());
+		});
+
+		const std::vector<Rect> opaque_region = merge_rects(panels);
+		run("subtract_rects/6", iterations / 100, [&opaque_region](int64_t) {
+			return static_cast<int64_t>(subtract_rects({ 0, 0, 1920, 1080 }, opaque_region).size());
+		});
+
+		// The mouse passthrough polygon of the same layout.
+		run("join_outlines/6", iterations / 100, [&opaque_region](int64_t) {
+			return static_cast<int64_t>(join_outlines(get_outlines(opaque_region)).size());
+		});
+
+		// What WM_NCHITTEST pays instead of walking the scene tree.
+		HitTestBuffer buffer;
+		HitTestSnapshot& snapshot = buffer.begin_write();
+		snapshot.blocking_region = opaque_region;
+		snapshot.drag_by_content = true;
+		buffer.publish();
+
+		run("hit_test_snapshot/6", iterations, [&buffer](int64_t i) {
+			Point point = { static_cast<int32_t>(i % 1920), static_cast<int32_t>((i / 7) % 1080) };
+			bool draggable = false;
+			buffer.read([&](const HitTestSnapshot& snapshot) {
+				draggable = is_draggable(snapshot, point);
+			});
+			return static_cast<int64_t>(draggable);
+		});
+	}
+
+	// Rows of the virtual popup read item texts while scrolling.
+	{
+		constexpr int item_count = 50000;
+		ItemTexts texts;
+		for (int i = 0; i < item_count; i++)
+			texts.add("res://assets/item_" + std::to_string(i) + ".tres");
+
+		run("item_texts_get/50000", iterations, [&texts](int64_t i) {
+			return static_cast<int64_t>(texts.get(static_cast<size_t>(i % item_count)).size());
+		});
+
+		// The index is rebuilt only when the items change.
+		run("search_index_build/50000", std::max<int64_t>(iterations / 100000, 1), [&texts](int64_t) {
+			SearchIndex index;
+			index.build(texts);
+			return static_cast<int64_t>(index.size());
+		});
+
+		SearchIndex index;
+		index.build(texts);
+
+		// One keystroke each. Typing "res://assets/item_4" refines a prefix query.
+		const std::string prefix = "RES://ASSETS/ITEM_4";
+		run("typeahead_prefix/50000", iterations / 100, [&index, &prefix](int64_t i) {
+			static Typeahead typeahead;
+			size_t length = static_cast<size_t>(i) % prefix.size();
+			if (length == 0)
+				typeahead.reset();
+
+			return static_cast<int64_t>(typeahead.type(index, prefix.substr(length, 1), 0, -1));
+		});
+
+		// Nothing starts with "m_4999", so it falls back to the trigrams.
+		const std::string substring = "m_4999";
+		run("typeahead_substring/50000", iterations / 100, [&index, &substring](int64_t i) {
+			static Typeahead typeahead;
+			size_t length = static_cast<size_t>(i) % substring.size();
+			if (length == 0)
+				typeahead.reset();
+
+			return static_cast<int64_t>(typeahead.type(index, substring.substr(length, 1), 0, -1));
+		});
+	}
+
+	return 0;
+}
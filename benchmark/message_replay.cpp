@@ -0,0 +1,179 @@
+/**************************************************************************/
+/*  message_replay.cpp                                                    */
+/*  Replays recorded native window messages through the core handlers.    */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "core/hit_test.hpp"
+#include "core/message.hpp"
+#include "core/message_log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Replays a recording of AcrylicWindow.start_message_recording through
+// acrylic::handle_message with the recorded geometry in place of the
+// native window, and prints one JSON object per message:
+// {"name":"WM_NCHITTEST","count":1200,"ns_per_op":41.250,"p99_ns":96}
+// followed by a summary:
+// {"name":"total","messages":1500,"mismatches":0,"duration_ms":8140.021}
+//
+// A mismatch is a message whose result differs from the recorded one,
+// i.e. the handlers have changed since the recording. The exit code is 1 then.
+// Timings include reading the clock around every message.
+//
+// Usage: message-replay <recording> [repeats]
+
+namespace {
+	// Keeps the optimizer from removing the replayed code.
+	volatile int64_t sink;
+
+	struct Window {
+		acrylic::MessageState state;
+		acrylic::Frame frame = acrylic::FRAME_DEFAULT;
+		acrylic::HitTestSnapshot snapshot;
+	};
+
+	struct Timings {
+		uint32_t id = 0;
+		std::vector<int64_t> durations;
+	};
+
+	Timings& get_timings(std::vector<Timings>& timings, uint32_t id) {
+		for (Timings& entry : timings) {
+			if (entry.id == id)
+				return entry;
+		}
+
+		timings.emplace_back();
+		timings.back().id = id;
+		return timings.back();
+	}
+
+	// Returns the number of mismatches.
+	int64_t replay(const std::vector<acrylic::MessageLogRecord>& records, std::vector<Timings>& timings) {
+		using namespace acrylic;
+
+		int64_t mismatches = 0;
+		std::vector<Window> windows;
+
+		for (const MessageLogRecord& record : records) {
+			if (record.window >= windows.size())
+				windows.resize(record.window + 1);
+
+			Window& window = windows[record.window];
+
+			switch (record.type) {
+			case MESSAGE_LOG_FRAME:
+				window.frame = record.frame;
+				break;
+
+			case MESSAGE_LOG_SNAPSHOT:
+				window.snapshot = record.snapshot;
+				break;
+
+			case MESSAGE_LOG_MESSAGE: {
+				auto start = std::chrono::steady_clock::now();
+				MessageResult result = handle_message(window.state, window.frame, window.snapshot, record.geometry, record.message);
+				auto end = std::chrono::steady_clock::now();
+
+				sink = sink + result.result;
+				get_timings(timings, record.message.id).durations.push_back(
+					std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+				if (result != record.result)
+					mismatches++;
+			} break;
+			}
+		}
+
+		return mismatches;
+	}
+}
+
+int main(int argc, char** argv) {
+	using namespace acrylic;
+
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s <recording> [repeats]\n", argv[0]);
+		return 1;
+	}
+
+	int64_t repeats = 100;
+	if (argc > 2)
+		repeats = std::atoll(argv[2]);
+
+	if (repeats <= 0) {
+		fprintf(stderr, "Invalid number of repeats: %s.\n", argv[2]);
+		return 1;
+	}
+
+	MessageLogReader reader;
+	if (!reader.open(argv[1])) {
+		fprintf(stderr, "Failed to open the recording %s.\n", argv[1]);
+		return 1;
+	}
+
+	std::vector<MessageLogRecord> records;
+	MessageLogRecord record;
+	int64_t messages = 0;
+	while (reader.read(&record)) {
+		if (record.type == MESSAGE_LOG_MESSAGE)
+			messages++;
+
+		records.push_back(record);
+	}
+
+	if (reader.is_corrupted()) {
+		fprintf(stderr, "The recording %s is corrupted after %lld records.\n", argv[1], static_cast<long long>(records.size()));
+		return 1;
+	}
+
+	// Every repeat starts from the recorded state, so all of them must match.
+	std::vector<Timings> timings;
+	int64_t mismatches = 0;
+	for (int64_t i = 0; i < repeats; i++)
+		mismatches += replay(records, timings);
+
+	for (Timings& entry : timings) {
+		std::vector<int64_t>& durations = entry.durations;
+
+		int64_t total = 0;
+		for (int64_t duration : durations)
+			total += duration;
+
+		size_t p99_index = durations.size() - 1 - durations.size() / 100;
+		std::nth_element(durations.begin(), durations.begin() + p99_index, durations.end());
+
+		const char* name = get_message_name(entry.id);
+		if (name)
+			printf("{\"name\":\"%s\",", name);
+		else
+			printf("{\"name\":\"0x%04X\",", entry.id);
+
+		printf("\"count\":%lld,\"ns_per_op\":%.3f,\"p99_ns\":%lld}\n",
+			static_cast<long long>(durations.size() / repeats),
+			static_cast<double>(total) / durations.size(),
+			static_cast<long long>(durations[p99_index]));
+	}
+
+	int64_t duration = 0;
+	for (const MessageLogRecord& entry : records) {
+		if (entry.type == MESSAGE_LOG_MESSAGE)
+			duration = std::max(duration, entry.message.time);
+	}
+
+	printf("{\"name\":\"total\",\"messages\":%lld,\"mismatches\":%lld,\"duration_ms\":%.3f}\n",
+		static_cast<long long>(messages), static_cast<long long>(mismatches / repeats), duration / 1e6);
+
+	return mismatches ? 1 : 0;
+}
@@ -20,16 +20,15 @@ extends AcrylicWindow
 #	Aspect = expand
 #	Scale = 1.5
 
-@onready var settings: AcrylicSettings = $AcrylicSettings
+# The settings panel builds its controls the first time it's shown.
+@onready var settings: AcrylicSettingsPanel = $AcrylicSettingsPanel
 @onready var title_bar: AcrylicTitleBar = $AcrylicTitleBar
 
 var settings_tween: Tween
 
 
 func _ready() -> void:
-	settings.set_preset(AcrylicSettings.Preset.AcrylicAmethyst)
-	# Show settings on open for demo.
-	title_bar.settings_button.button_pressed = true
+	settings.set_preset(AcrylicSettingsPanel.PRESET_ACRYLIC_AMETHYST)
 
 
 func _process(_delta: float) -> void:
@@ -42,14 +41,13 @@ func _on_acrylic_title_bar_settings_toggled(toggled_on: bool) -> void:
 	settings_tween = create_tween()
 	settings_tween.set_parallel(true)
 	if toggled_on:
+		settings.show()
 		settings_tween.tween_property(settings, "offset_right", -20, 0.2)
 		settings_tween.tween_property(settings, "modulate:a", 1, 0.2)
 	else:
 		settings_tween.tween_property(settings, "offset_right", 300, 0.4)
 		settings_tween.tween_property(settings, "modulate:a", 0, 0.4)
-		# This is a hack to release focus from settings.
-		# release_focus doesn't work.
-		settings.hide()
-		settings.show()
+		# Hiding also releases focus from settings.
+		settings_tween.chain().tween_callback(settings.hide)
 		
 		
@@ -0,0 +1,247 @@
+extends SceneTree
+
+#**************************************************************************#
+#  helpers_benchmark.gd                                                    #
+#  Times helpers and property setters on generated Control trees.          #
+#**************************************************************************#
+#  MIT License                                                             #
+#                                                                          #
+#  Alexander Vishnevsky (Sly)                                              #
+#  Check more on GitHub: https://github.com/slyisdreaming                  #
+#  Hug me: https://boosty.to/slyisdreaming                                 #
+#                                                                          #
+#**************************************************************************#
+
+# Run headless from the repository root:
+#   godot --headless --path demo --import
+#   godot --headless --path demo --script res://benchmark/helpers_benchmark.gd -- --output=helpers_benchmark.json
+#
+# Or build the `benchmark` CMake target.
+#
+# Arguments (after --):
+#   --output=<path>     Write JSON to the file instead of stdout.
+#   --iterations=<n>    Calls per measurement (default 100).
+#   --max-nodes=<n>     Skip trees larger than n nodes (default: run all).
+
+const TREES: Array[Dictionary] = [
+	{ "depth": 2, "fanout": 10 },     # 110 nodes
+	{ "depth": 1, "fanout": 1000 },   # 1000 nodes, flat
+	{ "depth": 3, "fanout": 10 },     # 1110 nodes
+	{ "depth": 10, "fanout": 2 },     # 2046 nodes, deep
+	{ "depth": 4, "fanout": 10 },     # 11110 nodes
+	{ "depth": 2, "fanout": 100 },    # 10100 nodes, wide
+	{ "depth": 5, "fanout": 10 },     # 111110 nodes
+	{ "depth": 16, "fanout": 2 },     # 131070 nodes, deep
+]
+
+const POPUP_COUNTS: Array[int] = [0, 10, 100]
+
+const SETTER_ITERATIONS := 200
+
+var iterations := 100
+var max_nodes := 0
+var output_path := ""
+
+
+func _initialize() -> void:
+	_parse_arguments()
+
+	var results: Array[Dictionary] = []
+
+	for tree in TREES:
+		var depth: int = tree.depth
+		var fanout: int = tree.fanout
+		var node_count := _get_node_count(depth, fanout)
+		if max_nodes > 0 and node_count > max_nodes:
+			continue
+
+		for popup_count in POPUP_COUNTS:
+			var content := Control.new()
+			content.mouse_filter = Control.MOUSE_FILTER_PASS
+			content.size = root.size
+			root.add_child(content)
+
+			var controls: Array[Control] = []
+			_build_tree(content, depth, fanout, controls)
+			var popups := _add_popups(controls, popup_count)
+
+			var info := {
+				"nodes": node_count,
+				"depth": depth,
+				"fanout": fanout,
+				"popups": popup_count,
+				"iterations": iterations,
+			}
+
+			# Worst case: every control passes the mouse so all of them are visited.
+			results.append(_result("find_mouse_blocking_control", info,
+				AcrylicBenchmark.time_find_mouse_blocking_control(root, Vector2(1, 1), iterations)))
+
+			# Worst case: no visible popups so all of them are visited.
+			results.append(_result("has_popup", info,
+				AcrylicBenchmark.time_has_popup(root, iterations)))
+
+			if not popups.is_empty():
+				popups.back().visible = true
+				results.append(_result("has_popup_visible", info,
+					AcrylicBenchmark.time_has_popup(root, iterations)))
+				popups.back().visible = false
+
+			root.remove_child(content)
+			content.free()
+
+	results.append_array(_benchmark_setters())
+
+	var report := {
+		"godot_version": Engine.get_version_info().string,
+		"os": OS.get_name(),
+		"processor": OS.get_processor_name(),
+		"results": results,
+	}
+
+	var json := JSON.stringify(report, "\t")
+	if output_path.is_empty():
+		print(json)
+	else:
+		var file := FileAccess.open(output_path, FileAccess.WRITE)
+		if not file:
+			push_error("Failed to open %s." % output_path)
+		else:
+			file.store_string(json)
+			file.close()
+			print("Benchmark results written to %s." % output_path)
+
+	quit()
+
+
+func _parse_arguments() -> void:
+	for argument in OS.get_cmdline_user_args():
+		if argument.begins_with("--output="):
+			output_path = argument.trim_prefix("--output=")
+		elif argument.begins_with("--iterations="):
+			iterations = maxi(1, argument.trim_prefix("--iterations=").to_int())
+		elif argument.begins_with("--max-nodes="):
+			max_nodes = maxi(1, argument.trim_prefix("--max-nodes=").to_int())
+
+
+func _get_node_count(depth: int, fanout: int) -> int:
+	var count := 0
+	var level := 1
+	for i in depth:
+		level *= fanout
+		count += level
+	return count
+
+
+func _build_tree(parent: Control, depth: int, fanout: int, controls: Array[Control]) -> void:
+	if depth == 0:
+		return
+
+	for i in fanout:
+		var control := Control.new()
+		control.mouse_filter = Control.MOUSE_FILTER_PASS
+		control.size = parent.size
+		parent.add_child(control)
+		controls.append(control)
+		_build_tree(control, depth - 1, fanout, controls)
+
+
+func _add_popups(controls: Array[Control], popup_count: int) -> Array[PopupMenu]:
+	var popups: Array[PopupMenu] = []
+	if popup_count == 0:
+		return popups
+
+	# Spread popups evenly so that has_popup has to walk the whole tree.
+	var step := maxi(1, controls.size() / popup_count)
+	for i in popup_count:
+		var popup := PopupMenu.new()
+		controls[mini(controls.size() - 1, (i + 1) * step - 1)].add_child(popup)
+		popups.append(popup)
+
+	return popups
+
+
+func _benchmark_setters() -> Array[Dictionary]:
+	var results: Array[Dictionary] = []
+
+	var window := AcrylicWindow.new()
+	root.add_child(window)
+
+	var info := { "iterations": SETTER_ITERATIONS }
+
+	var colors := [Color(0.1, 0.2, 0.3, 0.7), Color(0.8, 0.7, 0.6, 0.9)]
+	window.auto_colors = true
+	results.append(_result("set_base_color_auto_colors", info,
+		_time_setter(window, "base_color", colors)))
+
+	window.auto_colors = false
+	results.append(_result("set_base_color", info,
+		_time_setter(window, "base_color", colors)))
+	results.append(_result("set_border_color", info,
+		_time_setter(window, "border_color", colors)))
+	results.append(_result("set_clear_color", info,
+		_time_setter(window, "clear_color", colors)))
+
+	results.append(_result("set_backdrop", info,
+		_time_setter(window, "backdrop", [AcrylicWindow.BACKDROP_SOLID, AcrylicWindow.BACKDROP_ACRYLIC])))
+	results.append(_result("set_corner", info,
+		_time_setter(window, "corner", [AcrylicWindow.CORNER_ROUND, AcrylicWindow.CORNER_DONT_ROUND])))
+	results.append(_result("set_always_on_top", info,
+		_time_setter(window, "always_on_top", [false, true])))
+	results.append(_result("set_text_size", info,
+		_time_setter(window, "text_size", [1.0, 1.25])))
+
+	# Restoring a full style: one property at a time vs one set_style call.
+	var styles := [window.get_style(), window.get_style()]
+	styles[1].base_color = colors[1]
+	styles[1].backdrop = AcrylicWindow.BACKDROP_SOLID
+	styles[1].text_size = 1.25
+	results.append(_result("restore_style_properties", info,
+		_time_style_properties(window, styles)))
+	results.append(_result("get_style", info,
+		_time_get_style(window)))
+	results.append(_result("set_style", info,
+		_time_set_style(window, styles)))
+
+	root.remove_child(window)
+	window.free()
+
+	return results
+
+
+# Alternates values so that setters can't skip unchanged values.
+func _time_setter(object: Object, property: StringName, values: Array) -> float:
+	var start := Time.get_ticks_usec()
+	for i in SETTER_ITERATIONS:
+		object.set(property, values[i % values.size()])
+	return float(Time.get_ticks_usec() - start) / SETTER_ITERATIONS
+
+
+func _time_style_properties(object: Object, styles: Array) -> float:
+	var start := Time.get_ticks_usec()
+	for i in SETTER_ITERATIONS:
+		var style: Dictionary = styles[i % styles.size()]
+		for property in style:
+			object.set(property, style[property])
+	return float(Time.get_ticks_usec() - start) / SETTER_ITERATIONS
+
+
+func _time_get_style(window: AcrylicWindow) -> float:
+	var start := Time.get_ticks_usec()
+	for i in SETTER_ITERATIONS:
+		window.get_style()
+	return float(Time.get_ticks_usec() - start) / SETTER_ITERATIONS
+
+
+func _time_set_style(window: AcrylicWindow, styles: Array) -> float:
+	var start := Time.get_ticks_usec()
+	for i in SETTER_ITERATIONS:
+		window.set_style(styles[i % styles.size()])
+	return float(Time.get_ticks_usec() - start) / SETTER_ITERATIONS
+
+
+func _result(benchmark: String, info: Dictionary, usec_per_call: float) -> Dictionary:
+	var result := info.duplicate()
+	result["benchmark"] = benchmark
+	result["usec_per_call"] = usec_per_call
+	return result
@@ -0,0 +1,69 @@
+extends SceneTree
+
+#**************************************************************************#
+#  live_resize.gd                                                          #
+#  Checks that a live resize gives the layout of AcrylicWindow back.       #
+#**************************************************************************#
+#  MIT License                                                             #
+#                                                                          #
+#  Alexander Vishnevsky (Sly)                                              #
+#  Check more on GitHub: https://github.com/slyisdreaming                  #
+#  Hug me: https://boosty.to/slyisdreaming                                 #
+#                                                                          #
+#**************************************************************************#
+
+# Run headless from the repository root:
+#   godot --headless --path demo --script res://tests/live_resize.gd
+#
+# Or run ctest, which registers it as live-resize when godot is found.
+#
+# Begins and ends a live resize on AcrylicWindows with anchors that aren't
+# full rect and checks that the anchors and offsets are restored.
+# Exits with 1 if any differs.
+
+# Anchors and offsets in the order of Side: left, top, right, bottom.
+const LAYOUTS: Array[Dictionary] = [
+	{ "anchors": [0.0, 0.0, 1.0, 1.0], "offsets": [0.0, 0.0, 0.0, 0.0] },
+	{ "anchors": [1.0, 1.0, 1.0, 1.0], "offsets": [-200.0, -100.0, -10.0, -20.0] },
+	{ "anchors": [0.5, 0.25, 1.0, 0.75], "offsets": [10.0, 20.0, -30.0, -40.0] },
+	{ "anchors": [0.0, 0.5, 0.5, 0.5], "offsets": [5.0, -50.0, 0.0, 50.0] },
+]
+
+var failures := 0
+
+
+func _initialize() -> void:
+	for i in LAYOUTS.size():
+		_check_layout(i, LAYOUTS[i])
+
+	print("live-resize: %d layouts, %d failed" % [LAYOUTS.size(), failures])
+	quit(1 if failures else 0)
+
+
+func _check_layout(index: int, layout: Dictionary) -> void:
+	var window := AcrylicWindow.new()
+	root.add_child(window)
+
+	for side in 4:
+		window.set_anchor(side, layout.anchors[side], false, true)
+	for side in 4:
+		window.set_offset(side, layout.offsets[side])
+
+	window.begin_live_resize(true)
+	if not window.is_live_resizing():
+		_fail(index, "begin_live_resize didn't start a live resize")
+	window.end_live_resize()
+
+	for side in 4:
+		if not is_equal_approx(window.get_anchor(side), layout.anchors[side]):
+			_fail(index, "anchor %d is %s, expected %s" % [side, window.get_anchor(side), layout.anchors[side]])
+		if not is_equal_approx(window.get_offset(side), layout.offsets[side]):
+			_fail(index, "offset %d is %s, expected %s" % [side, window.get_offset(side), layout.offsets[side]])
+
+	root.remove_child(window)
+	window.free()
+
+
+func _fail(index: int, what: String) -> void:
+	failures += 1
+	printerr("Layout %d: %s." % [index, what])
@@ -0,0 +1,59 @@
+extends SceneTree
+
+#**************************************************************************#
+#  reenter_tree.gd                                                         #
+#  Checks that AcrylicWindow sets itself up again when re-added.           #
+#**************************************************************************#
+#  MIT License                                                             #
+#                                                                          #
+#  Alexander Vishnevsky (Sly)                                              #
+#  Check more on GitHub: https://github.com/slyisdreaming                  #
+#  Hug me: https://boosty.to/slyisdreaming                                 #
+#                                                                          #
+#**************************************************************************#
+
+# Run headless from the repository root:
+#   godot --headless --path demo --script res://tests/reenter_tree.gd
+#
+# Or run ctest, which registers it as reenter-tree when godot is found.
+#
+# Removes an AcrylicWindow from the tree and adds it back a few times.
+# Exits with 1 if it isn't registered or has more than one DimRect after that.
+
+const ATTEMPTS := 3
+
+var failures := 0
+
+
+func _initialize() -> void:
+	var window := AcrylicWindow.new()
+	var window_id := root.get_window_id()
+
+	for attempt in ATTEMPTS:
+		root.add_child(window)
+		_expect(AcrylicWindow.find_by_window_id(window_id) == window, attempt, "isn't registered")
+		_expect(_count_dim_rects(window) == 1, attempt, "has %d DimRects" % _count_dim_rects(window))
+
+		root.remove_child(window)
+		_expect(AcrylicWindow.find_by_window_id(window_id) == null, attempt, "is still registered after removal")
+
+	window.free()
+
+	print("reenter-tree: %d attempts, %d failed" % [ATTEMPTS, failures])
+	quit(1 if failures else 0)
+
+
+func _count_dim_rects(window: AcrylicWindow) -> int:
+	var count := 0
+	for child in window.get_children(true):
+		if child.name.begins_with("DimRect"):
+			count += 1
+	return count
+
+
+func _expect(condition: bool, attempt: int, what: String) -> void:
+	if condition:
+		return
+
+	failures += 1
+	printerr("Attempt %d: AcrylicWindow %s." % [attempt, what])
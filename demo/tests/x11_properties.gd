@@ -0,0 +1,125 @@
+extends SceneTree
+
+#**************************************************************************#
+#  x11_properties.gd                                                       #
+#  Reads back the X11 properties written by AcrylicWindow.                 #
+#**************************************************************************#
+#  MIT License                                                             #
+#                                                                          #
+#  Alexander Vishnevsky (Sly)                                              #
+#  Check more on GitHub: https://github.com/slyisdreaming                  #
+#  Hug me: https://boosty.to/slyisdreaming                                 #
+#                                                                          #
+#**************************************************************************#
+
+# Run on an X server without a desktop from the repository root:
+#   xvfb-run -a godot --rendering-driver opengl3 --path demo --script res://tests/x11_properties.gd
+#
+# Or run ctest, which registers it as x11-properties when godot, xvfb-run
+# and xprop are found.
+#
+# Applies every case to an AcrylicWindow in the root window, waits for the
+# batched writes and checks the properties with xprop. Exits with 1 if any
+# property differs.
+
+# _MOTIF_WM_HINTS: flags, functions, decorations, input mode, status.
+# The first case leaves frame unset, so the decorations must be left alone.
+const CASES: Array[Dictionary] = [
+	{ "frame": null, "always_on_top": false, "motif_hints": null },
+	{ "frame": AcrylicWindow.FRAME_CUSTOM, "always_on_top": true, "motif_hints": "0x2, 0x0, 0x0, 0x0, 0x0" },
+	{ "frame": AcrylicWindow.FRAME_DEFAULT, "always_on_top": false, "motif_hints": "0x2, 0x0, 0x1, 0x0, 0x0" },
+	{ "frame": AcrylicWindow.FRAME_BORDERLESS, "always_on_top": true, "motif_hints": "0x2, 0x0, 0x0, 0x0, 0x0" },
+]
+
+# The writes are flushed at the end of a frame. Leave time for Godot's own.
+const FRAMES_PER_CASE := 10
+
+var window: AcrylicWindow
+var case_index := 0
+var frames := 0
+var failures := 0
+
+
+func _initialize() -> void:
+	if DisplayServer.get_name() != "X11":
+		push_error("x11_properties.gd needs the X11 display server, got %s." % DisplayServer.get_name())
+		quit(1)
+		return
+
+	window = AcrylicWindow.new()
+	root.add_child(window)
+	_apply_case()
+
+
+func _process(_delta: float) -> bool:
+	if case_index >= CASES.size():
+		return false
+
+	frames += 1
+	if frames < FRAMES_PER_CASE:
+		return false
+
+	_check_case()
+
+	case_index += 1
+	frames = 0
+	if case_index < CASES.size():
+		_apply_case()
+		return false
+
+	print("x11-properties: %d cases, %d failed" % [CASES.size(), failures])
+	quit(1 if failures else 0)
+	return false
+
+
+func _apply_case() -> void:
+	var test_case: Dictionary = CASES[case_index]
+	if test_case.frame != null:
+		window.frame = test_case.frame
+	window.always_on_top = test_case.always_on_top
+
+
+func _check_case() -> void:
+	var test_case: Dictionary = CASES[case_index]
+	var properties := _read_properties()
+
+	if test_case.motif_hints != null:
+		_expect(properties.get("_MOTIF_WM_HINTS", ""), test_case.motif_hints, "_MOTIF_WM_HINTS")
+
+	var above: bool = "_NET_WM_STATE_ABOVE" in properties.get("_NET_WM_STATE", "")
+	_expect(above, test_case.always_on_top, "_NET_WM_STATE_ABOVE")
+
+	_expect(properties.get("_NET_WM_WINDOW_TYPE", ""), "_NET_WM_WINDOW_TYPE_NORMAL", "_NET_WM_WINDOW_TYPE")
+
+	var borderless: bool = test_case.frame != null and test_case.frame != AcrylicWindow.FRAME_DEFAULT
+	_expect(root.borderless, borderless, "Window.borderless")
+	_expect(root.always_on_top, test_case.always_on_top, "Window.always_on_top")
+
+
+# Returns the value text of every property xprop printed, by property name.
+func _read_properties() -> Dictionary:
+	var handle := DisplayServer.window_get_native_handle(DisplayServer.WINDOW_HANDLE, DisplayServer.MAIN_WINDOW_ID)
+	var output: Array = []
+	var exit_code := OS.execute("xprop", ["-id", str(handle),
+		"_MOTIF_WM_HINTS", "_NET_WM_STATE", "_NET_WM_WINDOW_TYPE"], output)
+	if exit_code != 0:
+		push_error("Failed to run xprop (%d)." % exit_code)
+		return {}
+
+	# One line per property: NAME(TYPE) = VALUE
+	var properties := {}
+	for line in "".join(output).split("\n", false):
+		var separator := line.find(" = ")
+		var type_start := line.find("(")
+		if separator == -1 or type_start == -1:
+			continue
+		properties[line.substr(0, type_start)] = line.substr(separator + 3).strip_edges()
+	return properties
+
+
+func _expect(actual: Variant, expected: Variant, what: String) -> void:
+	if actual == expected:
+		return
+
+	failures += 1
+	printerr("Case %d: %s is %s, expected %s." % [case_index, what, str(actual), str(expected)])
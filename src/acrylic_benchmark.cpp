@@ -0,0 +1,78 @@
+/**************************************************************************/
+/*  acrylic_benchmark.cpp                                                 */
+/*  Native timing loops for the headless benchmark suite.                 */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "acrylic_benchmark.hpp"
+
+#include <godot_cpp/classes/control.hpp>
+#include <godot_cpp/classes/window.hpp>
+
+#include <chrono>
+
+namespace {
+	constexpr char PRINT_CATEGORY[] = "helpers";
+
+	using clock = std::chrono::steady_clock;
+
+	double get_usec_per_call(clock::time_point start, int iterations) {
+		std::chrono::duration<double, std::micro> elapsed = clock::now() - start;
+		return elapsed.count() / iterations;
+	}
+}
+
+namespace godot {
+
+double AcrylicBenchmark::time_has_popup(Window* window, int iterations) {
+	if (!window || iterations <= 0) {
+		print_error("Invalid arguments.");
+		return -1;
+	}
+
+	int found = 0;
+
+	clock::time_point start = clock::now();
+	for (int i = 0; i < iterations; i++) {
+		if (has_popup(window))
+			found++;
+	}
+
+	double result = get_usec_per_call(start, iterations);
+	print_debug("Found popups: %d.", found);
+
+	return result;
+}
+
+double AcrylicBenchmark::time_find_mouse_blocking_control(Window* window, const Vector2& position, int iterations) {
+	if (!window || iterations <= 0) {
+		print_error("Invalid arguments.");
+		return -1;
+	}
+
+	int found = 0;
+
+	clock::time_point start = clock::now();
+	for (int i = 0; i < iterations; i++) {
+		if (find_mouse_blocking_control(window, position))
+			found++;
+	}
+
+	double result = get_usec_per_call(start, iterations);
+	print_debug("Found blocking controls: %d.", found);
+
+	return result;
+}
+
+void AcrylicBenchmark::_bind_methods() {
+	ClassDB::bind_static_method("AcrylicBenchmark", D_METHOD("time_has_popup", "window", "iterations"), &AcrylicBenchmark::time_has_popup);
+	ClassDB::bind_static_method("AcrylicBenchmark", D_METHOD("time_find_mouse_blocking_control", "window", "position", "iterations"), &AcrylicBenchmark::time_find_mouse_blocking_control);
+}
+
+}
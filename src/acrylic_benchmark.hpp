@@ -0,0 +1,37 @@
+/**************************************************************************/
+/*  acrylic_benchmark.hpp                                                 */
+/*  Native timing loops for the headless benchmark suite.                 */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "helpers.hpp"
+
+#include <godot_cpp/classes/object.hpp>
+
+namespace godot {
+
+class Window;
+
+// Times the helpers without the GDScript call overhead.
+// Used by demo/benchmark/helpers_benchmark.gd.
+class AcrylicBenchmark : public Object {
+	GDCLASS(AcrylicBenchmark, Object)
+
+public:
+	// Return average time per call in microseconds.
+	static double time_has_popup(Window* window, int iterations);
+	static double time_find_mouse_blocking_control(Window* window, const Vector2& position, int iterations);
+
+protected:
+	static void _bind_methods();
+};
+
+}
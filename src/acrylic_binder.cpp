@@ -0,0 +1,254 @@
+/**************************************************************************/
+/*  acrylic_binder.cpp                                                    */
+/*  Two-way binding of AcrylicWindow properties and controls.             */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "acrylic_binder.hpp"
+
+#include "acrylic_window.hpp"
+#include "trace.hpp"
+
+#include <godot_cpp/classes/control.hpp>
+
+namespace {
+	constexpr char PRINT_CATEGORY[] = "AcrylicBinder";
+
+	using namespace godot;
+
+	struct DefaultSignal {
+		const char* control_property;
+		const char* control_signal;
+	};
+
+	constexpr DefaultSignal DEFAULT_SIGNALS[] = {
+		{ "value", "value_changed" },
+		{ "button_pressed", "toggled" },
+		{ "selected", "item_selected" },
+		{ "color", "color_changed" },
+		{ "text", "text_changed" }
+	};
+
+	StringName get_default_signal(const StringName& control_property) {
+		for (const DefaultSignal& default_signal : DEFAULT_SIGNALS) {
+			if (control_property == StringName(default_signal.control_property))
+				return default_signal.control_signal;
+		}
+
+		return StringName();
+	}
+
+	// Returns -1 if the object has no such signal.
+	int get_signal_argument_count(Object* object, const StringName& signal) {
+		TypedArray<Dictionary> signals = object->get_signal_list();
+		for (int64_t i = 0; i < signals.size(); i++) {
+			Dictionary info = signals[i];
+			if (StringName(info["name"]) == signal)
+				return static_cast<int>(Array(info["args"]).size());
+		}
+
+		return -1;
+	}
+}
+
+namespace godot {
+
+bool AcrylicBinder::bind(const StringName& property, Control* control, const StringName& control_property, const StringName& control_signal) {
+	if (!control) {
+		print_error("Control is null.");
+		return false;
+	}
+
+	AcrylicWindow* window = Object::cast_to<AcrylicWindow>(get_node_or_null(acrylic_window));
+	if (!window) {
+		print_error("Failed to find AcrylicWindow at %s.", String(acrylic_window).utf8().get_data());
+		return false;
+	}
+
+	StringName window_signal = String(property) + "_changed";
+	int window_argument_count = get_signal_argument_count(window, window_signal);
+	if (window_argument_count < 0) {
+		print_error("AcrylicWindow has no property %s with a signal.", String(property).utf8().get_data());
+		return false;
+	}
+
+	StringName signal = control_signal.is_empty() ? get_default_signal(control_property) : control_signal;
+	int control_argument_count = signal.is_empty() ? -1 : get_signal_argument_count(control, signal);
+	if (control_argument_count < 0) {
+		print_error("Failed to find the signal of %s.%s.", control->get_name().c_escape().utf8().get_data(), String(control_property).utf8().get_data());
+		return false;
+	}
+
+	int index = 0;
+	while (index < static_cast<int>(bindings.size()) && bindings[index].control != 0)
+		index++;
+
+	if (index == static_cast<int>(bindings.size()))
+		bindings.emplace_back();
+
+	Binding& binding = bindings[index];
+	binding.window = window->get_instance_id();
+	binding.control = control->get_instance_id();
+	binding.property = property;
+	binding.control_property = control_property;
+	binding.control_signal = signal;
+	binding.window_callable = callable_mp(this, &AcrylicBinder::on_window_changed).bind(index).unbind(window_argument_count);
+	binding.control_callable = callable_mp(this, &AcrylicBinder::on_control_changed).bind(index).unbind(control_argument_count);
+	binding.dirty = false;
+
+	window->connect(window_signal, binding.window_callable);
+	control->connect(signal, binding.control_callable);
+
+	sync_control(binding);
+
+	return true;
+}
+
+void AcrylicBinder::unbind(Control* control) {
+	if (!control)
+		return;
+
+	uint64_t id = control->get_instance_id();
+	for (Binding& binding : bindings) {
+		if (binding.control == id)
+			remove_binding(binding);
+	}
+}
+
+void AcrylicBinder::unbind_all() {
+	for (Binding& binding : bindings) {
+		if (binding.control != 0)
+			remove_binding(binding);
+	}
+
+	bindings.clear();
+	dirty = false;
+	set_process(false);
+}
+
+int AcrylicBinder::get_binding_count() const {
+	int count = 0;
+	for (const Binding& binding : bindings) {
+		if (binding.control != 0)
+			count++;
+	}
+
+	return count;
+}
+
+void AcrylicBinder::flush() {
+	if (!dirty)
+		return;
+
+	TRACE_SCOPE("AcrylicBinder::flush");
+
+	dirty = false;
+	set_process(false);
+
+	for (Binding& binding : bindings) {
+		if (!binding.dirty)
+			continue;
+
+		binding.dirty = false;
+		sync_control(binding);
+	}
+}
+
+void AcrylicBinder::_notification(int p_what) {
+	switch (p_what) {
+	case NOTIFICATION_READY:
+		set_process(dirty);
+		break;
+
+	case NOTIFICATION_PROCESS:
+		flush();
+		break;
+	}
+}
+
+void AcrylicBinder::_bind_methods() {
+	BIND_PROPERTY_HINT(AcrylicBinder, Variant::NODE_PATH, acrylic_window, PROPERTY_HINT_NODE_PATH_VALID_TYPES, "AcrylicWindow");
+
+	ClassDB::bind_method(D_METHOD("bind", "property", "control", "control_property", "control_signal"), &AcrylicBinder::bind, DEFVAL(StringName()));
+	BIND_FUNCTION(AcrylicBinder, unbind, "control");
+	BIND_FUNCTION(AcrylicBinder, unbind_all);
+	BIND_FUNCTION(AcrylicBinder, get_binding_count);
+	BIND_FUNCTION(AcrylicBinder, flush);
+}
+
+#pragma region PROPERTIES
+
+DEFINE_PROPERTY_GET(AcrylicBinder, NodePath, acrylic_window)
+DEFINE_PROPERTY_SET(AcrylicBinder, NodePath&, acrylic_window)
+
+#pragma endregion
+
+void AcrylicBinder::sync_control(Binding& binding) {
+	Object* window = ObjectDB::get_instance(binding.window);
+	Object* control = ObjectDB::get_instance(binding.control);
+	if (!window || !control) {
+		remove_binding(binding);
+		return;
+	}
+
+	Variant value = window->get(binding.property);
+	if (control->get(binding.control_property) == value)
+		return;
+
+	syncing = true;
+	control->set(binding.control_property, value);
+	syncing = false;
+}
+
+void AcrylicBinder::remove_binding(Binding& binding) {
+	Object* window = ObjectDB::get_instance(binding.window);
+	if (window && window->is_connected(String(binding.property) + "_changed", binding.window_callable))
+		window->disconnect(String(binding.property) + "_changed", binding.window_callable);
+
+	Object* control = ObjectDB::get_instance(binding.control);
+	if (control && control->is_connected(binding.control_signal, binding.control_callable))
+		control->disconnect(binding.control_signal, binding.control_callable);
+
+	binding = Binding();
+}
+
+void AcrylicBinder::on_window_changed(int index) {
+	Binding& binding = bindings[index];
+	if (binding.dirty)
+		return;
+
+	binding.dirty = true;
+	if (!dirty) {
+		dirty = true;
+		set_process(true);
+	}
+}
+
+void AcrylicBinder::on_control_changed(int index) {
+	if (syncing)
+		return;
+
+	Binding& binding = bindings[index];
+	Object* window = ObjectDB::get_instance(binding.window);
+	Object* control = ObjectDB::get_instance(binding.control);
+	if (!window || !control)
+		return;
+
+	Variant value = control->get(binding.control_property);
+	if (window->get(binding.property) == value)
+		return;
+
+	// The window may adjust the value. Its *_changed signal
+	// brings the adjusted value back to the control next frame.
+	syncing = true;
+	window->set(binding.property, value);
+	syncing = false;
+}
+
+}
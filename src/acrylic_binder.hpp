@@ -0,0 +1,97 @@
+/**************************************************************************/
+/*  acrylic_binder.hpp                                                    */
+/*  Two-way binding of AcrylicWindow properties and controls.             */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "helpers.hpp"
+
+#include <godot_cpp/classes/node.hpp>
+
+#include <vector>
+
+namespace godot {
+
+class AcrylicWindow;
+class Control;
+
+// EXAMPLES
+// var binder := AcrylicBinder.new()
+// add_child(binder) # acrylic_window is ".." by default.
+// binder.bind("base_color", $BaseColorButton, "color")
+// binder.bind("text_size", $TextSizeSlider, "value")
+// binder.bind("backdrop", $BackdropButton, "selected")
+//
+// Changes of the control are written to the window right away.
+// Changes of the window are written to the controls once per frame, so
+// a property changed many times in a frame updates its controls once.
+//
+// A value is written only if it differs from the current one, and the
+// control signals emitted while the binder updates controls are ignored.
+// This breaks the loop control -> window -> *_changed -> control.
+class AcrylicBinder : public Node {
+	GDCLASS(AcrylicBinder, Node)
+
+public:
+	DECLARE_PROPERTY(NodePath&, acrylic_window, NodePath(".."))
+
+public:
+	// If control_signal is empty it's deduced from control_property:
+	//   value -> value_changed
+	//   button_pressed -> toggled
+	//   selected -> item_selected
+	//   color -> color_changed
+	//   text -> text_changed
+	// The control is updated from the window immediately.
+	//
+	// The window side relies on <property>_changed, so only properties whose
+	// setter and set_style emit it stay two-way. All the style properties of
+	// AcrylicWindow with a signal do.
+	bool bind(const StringName& property, Control* control, const StringName& control_property, const StringName& control_signal = StringName());
+	void unbind(Control* control);
+	void unbind_all();
+	int get_binding_count() const;
+
+	// Updates the controls of the changed properties now instead of next frame.
+	void flush();
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+private:
+	struct Binding {
+		uint64_t window = 0;
+		uint64_t control = 0;
+		StringName property;
+		StringName control_property;
+		Callable window_callable;
+		Callable control_callable;
+		StringName control_signal;
+		bool dirty = false;
+	};
+
+private:
+	void sync_control(Binding& binding);
+	void remove_binding(Binding& binding);
+
+	void on_window_changed(int index);
+	void on_control_changed(int index);
+
+private:
+	// Unbound slots have no control and are reused.
+	std::vector<Binding> bindings;
+	bool dirty = false;
+	// Set while the binder writes a value, to ignore the resulting signals.
+	bool syncing = false;
+};
+
+}
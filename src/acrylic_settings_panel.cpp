@@ -0,0 +1,328 @@
+/**************************************************************************/
+/*  acrylic_settings_panel.cpp                                            */
+/*  Settings of AcrylicWindow built the first time they are shown.        */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "acrylic_settings_panel.hpp"
+
+#include "acrylic_binder.hpp"
+#include "acrylic_window.hpp"
+#include "helpers.hpp"
+#include "scrollable_option_button.hpp"
+#include "trace.hpp"
+
+#include <godot_cpp/classes/check_button.hpp>
+#include <godot_cpp/classes/color_picker_button.hpp>
+#include <godot_cpp/classes/h_slider.hpp>
+#include <godot_cpp/classes/label.hpp>
+#include <godot_cpp/classes/theme.hpp>
+
+namespace {
+	constexpr char PRINT_CATEGORY[] = "AcrylicSettingsPanel";
+
+	using godot::AcrylicWindow;
+
+	enum RowType {
+		ROW_SLIDER,
+		ROW_CHECK,
+		ROW_OPTION,
+		ROW_COLOR
+	};
+
+	struct Row {
+		const char* label;
+		const char* property;
+		RowType type;
+		// Comma separated items of ROW_OPTION.
+		const char* items = nullptr;
+		double min = 0;
+		double max = 1;
+		double step = 0;
+	};
+
+	// The control of each row is bound to the property of AcrylicWindow.
+	constexpr Row ROWS[] = {
+		{ "Text Size", "text_size", ROW_SLIDER, nullptr, 1, 2, 0.25 },
+		{ "Always on Top", "always_on_top", ROW_CHECK },
+		{ "Drag by Content", "drag_by_content", ROW_CHECK },
+		{ "Drag by Right Click", "drag_by_right_click", ROW_CHECK },
+		{ "Dim Strength", "dim_strength", ROW_SLIDER, nullptr, 0, 1, 0.05 },
+		{ "Frame", "frame", ROW_OPTION, "Default,Borderless,Custom" },
+		{ "Backdrop", "backdrop", ROW_OPTION, "Solid,Transparent,Acrylic,Mica,Tabbed" },
+		{ "Corner", "corner", ROW_OPTION, "Default,Don't Round,Round,Round Small" },
+		{ "Autohide Title Bar", "autohide_title_bar", ROW_OPTION, "Never,Always,Maximized" },
+		{ "Accent Title Bar", "accent_title_bar", ROW_OPTION, "Never,Always,Mouse Over" },
+		{ "Auto Colors", "auto_colors", ROW_CHECK },
+		{ "Base Color", "base_color", ROW_COLOR },
+		{ "Border Color", "border_color", ROW_COLOR },
+		{ "Title Bar Color", "title_bar_color", ROW_COLOR },
+		{ "Text Color", "text_color", ROW_COLOR },
+		{ "Clear Color", "clear_color", ROW_COLOR }
+	};
+
+	// The property of the control bound to the window, per RowType.
+	constexpr const char* CONTROL_PROPERTIES[] = {
+		"value",
+		"button_pressed",
+		"selected",
+		"color"
+	};
+
+	constexpr int ROW_COUNT = sizeof(ROWS) / sizeof(ROWS[0]);
+	constexpr int ROW_TEXT_SIZE = 0;
+	// Colors derived from the base color are hidden with auto_colors.
+	constexpr int ROW_FIRST_DERIVED_COLOR = 12;
+
+	struct PresetStyle {
+		const char* name;
+		AcrylicWindow::Backdrop backdrop;
+		bool auto_colors;
+		// RGBA. Only base_color is used with auto_colors.
+		uint32_t base_color;
+		uint32_t border_color;
+		uint32_t title_bar_color;
+		uint32_t text_color;
+		uint32_t clear_color;
+	};
+
+	constexpr PresetStyle PRESETS[] = {
+		{ "AcrylicAmethyst", AcrylicWindow::BACKDROP_ACRYLIC, false, 0x050e2e84, 0x080c1da1, 0x080c1da1, 0xffffffff, 0x01020784 },
+		{ "AcrylicGlass", AcrylicWindow::BACKDROP_ACRYLIC, false, 0x00000000, 0x393939ff, 0x00000028, 0xffffffff, 0x02020200 },
+		{ "AcrylicBlue", AcrylicWindow::BACKDROP_ACRYLIC, false, 0x224ff284, 0x2f469ba1, 0x0c2994a1, 0xffffffff, 0x050c2484 },
+		{ "AcrylicFaintBlue", AcrylicWindow::BACKDROP_ACRYLIC, false, 0x224ff234, 0x374162a3, 0x212841a3, 0xffffffff, 0x050c2434 },
+		{ "AcrylicRed", AcrylicWindow::BACKDROP_ACRYLIC, false, 0xd80d0d9b, 0x941818a9, 0x860101a9, 0xffffffff, 0x2002029b },
+		{ "AcrylicGreen", AcrylicWindow::BACKDROP_ACRYLIC, false, 0x1dd06434, 0x678b75a3, 0x2d512da3, 0xffffffff, 0x041f0f34 },
+		{ "AcrylicGray", AcrylicWindow::BACKDROP_ACRYLIC, false, 0x585858bd, 0x525252be, 0x3c3c3cbe, 0xffffffff, 0x0d0d0dbd },
+		{ "AcrylicBlack", AcrylicWindow::BACKDROP_ACRYLIC, true, 0x0e0e0ebd, 0, 0, 0, 0 },
+		{ "AcrylicWhite", AcrylicWindow::BACKDROP_ACRYLIC, false, 0xffffffc2, 0xf0f0f0c1, 0x8f8f8f8e, 0x000000ff, 0x262626c2 },
+		{ "MicaBlue", AcrylicWindow::BACKDROP_MICA, false, 0x224ff27e, 0x3046969f, 0x051c739f, 0xffffffff, 0x050c247e },
+		{ "MicaRed", AcrylicWindow::BACKDROP_MICA, false, 0xd80d0d9b, 0x941818a9, 0x6f0000a9, 0xffffffff, 0x2002029b },
+		{ "MicaGreen", AcrylicWindow::BACKDROP_MICA, true, 0x14bc6491, 0, 0, 0, 0 },
+		{ "MicaGray", AcrylicWindow::BACKDROP_MICA, false, 0x4d4d4dce, 0x161616be, 0x262626be, 0xffffffff, 0x0c0c0cce },
+		{ "MicaBlack", AcrylicWindow::BACKDROP_MICA, false, 0x181818af, 0x0f0f0fbe, 0x2e2d2dbe, 0xffffffff, 0x020202bd },
+		{ "MicaWhite", AcrylicWindow::BACKDROP_MICA, false, 0xfffffff4, 0xfcfcfcf2, 0x8f8f8f8e, 0x000000ff, 0x262626f4 }
+	};
+
+	static_assert(sizeof(PRESETS) / sizeof(PRESETS[0]) == godot::AcrylicSettingsPanel::PRESET_MAX,
+		"PRESETS are out of sync with AcrylicSettingsPanel::Preset.");
+}
+
+namespace godot {
+
+void AcrylicSettingsPanel::set_preset(Preset p_preset) {
+	if (p_preset < 0 || p_preset >= PRESET_MAX) {
+		print_error("Invalid preset %d.", static_cast<int>(p_preset));
+		return;
+	}
+
+	AcrylicWindow* window = get_window();
+	if (!window) {
+		print_error("Failed to find AcrylicWindow at %s.", String(acrylic_window).utf8().get_data());
+		return;
+	}
+
+	preset = p_preset;
+	if (preset_button)
+		preset_button->select(preset);
+
+	const PresetStyle& style = PRESETS[preset];
+	window->set_backdrop(style.backdrop);
+	window->set_auto_colors(style.auto_colors);
+	window->set_base_color(Color::hex(style.base_color));
+
+	if (style.auto_colors)
+		return;
+
+	window->set_border_color(Color::hex(style.border_color));
+	window->set_title_bar_color(Color::hex(style.title_bar_color));
+	window->set_text_color(Color::hex(style.text_color));
+	window->set_clear_color(Color::hex(style.clear_color));
+}
+
+void AcrylicSettingsPanel::build() {
+	if (built)
+		return;
+
+	AcrylicWindow* window = get_window();
+	if (!window) {
+		print_error("Failed to find AcrylicWindow at %s.", String(acrylic_window).utf8().get_data());
+		return;
+	}
+
+	TRACE_SCOPE("AcrylicSettingsPanel::build");
+
+	built = true;
+
+	Label* preset_label = memnew(Label);
+	monitor_node(preset_label);
+	preset_label->set_text("Preset");
+	add_child(preset_label);
+
+	preset_button = memnew(ScrollableOptionButton);
+	monitor_node(preset_button);
+	for (const PresetStyle& style : PRESETS)
+		preset_button->add_item(style.name);
+	preset_button->select(preset == PRESET_MAX ? -1 : preset);
+	preset_button->connect("item_selected", callable_mp(this, &AcrylicSettingsPanel::on_preset_selected));
+	add_child(preset_button);
+
+	// Gap between the presets and the properties.
+	for (int i = 0; i < 2; i++) {
+		Control* spacer = memnew(Control);
+		monitor_node(spacer);
+		spacer->set_custom_minimum_size(Vector2(0, i == 0 ? 25 : 0));
+		add_child(spacer);
+	}
+
+	binder = memnew(AcrylicBinder);
+	monitor_node(binder);
+	add_child(binder);
+	binder->set_acrylic_window(binder->get_path_to(window));
+
+	labels.reserve(ROW_COUNT);
+	controls.reserve(ROW_COUNT);
+	for (int row = 0; row < ROW_COUNT; row++)
+		add_row(row);
+
+	on_auto_colors_changed(window->get_auto_colors());
+	on_text_color_changed(window->get_text_color());
+	window->connect("auto_colors_changed", callable_mp(this, &AcrylicSettingsPanel::on_auto_colors_changed));
+	window->connect("text_color_changed", callable_mp(this, &AcrylicSettingsPanel::on_text_color_changed));
+}
+
+bool AcrylicSettingsPanel::is_built() const {
+	return built;
+}
+
+void AcrylicSettingsPanel::_notification(int p_what) {
+	switch (p_what) {
+	case NOTIFICATION_READY:
+	case NOTIFICATION_VISIBILITY_CHANGED:
+		if (!built && !is_editor() && is_inside_tree() && is_visible_in_tree())
+			build();
+		break;
+	}
+}
+
+void AcrylicSettingsPanel::_bind_methods() {
+	BIND_ENUM_CONSTANT(PRESET_ACRYLIC_AMETHYST);
+	BIND_ENUM_CONSTANT(PRESET_ACRYLIC_GLASS);
+	BIND_ENUM_CONSTANT(PRESET_ACRYLIC_BLUE);
+	BIND_ENUM_CONSTANT(PRESET_ACRYLIC_FAINT_BLUE);
+	BIND_ENUM_CONSTANT(PRESET_ACRYLIC_RED);
+	BIND_ENUM_CONSTANT(PRESET_ACRYLIC_GREEN);
+	BIND_ENUM_CONSTANT(PRESET_ACRYLIC_GRAY);
+	BIND_ENUM_CONSTANT(PRESET_ACRYLIC_BLACK);
+	BIND_ENUM_CONSTANT(PRESET_ACRYLIC_WHITE);
+	BIND_ENUM_CONSTANT(PRESET_MICA_BLUE);
+	BIND_ENUM_CONSTANT(PRESET_MICA_RED);
+	BIND_ENUM_CONSTANT(PRESET_MICA_GREEN);
+	BIND_ENUM_CONSTANT(PRESET_MICA_GRAY);
+	BIND_ENUM_CONSTANT(PRESET_MICA_BLACK);
+	BIND_ENUM_CONSTANT(PRESET_MICA_WHITE);
+
+	BIND_PROPERTY_HINT(AcrylicSettingsPanel, Variant::NODE_PATH, acrylic_window, PROPERTY_HINT_NODE_PATH_VALID_TYPES, "AcrylicWindow");
+
+	BIND_FUNCTION(AcrylicSettingsPanel, set_preset, "preset");
+	BIND_FUNCTION(AcrylicSettingsPanel, build);
+	BIND_FUNCTION(AcrylicSettingsPanel, is_built);
+}
+
+#pragma region PROPERTIES
+
+DEFINE_PROPERTY_GET(AcrylicSettingsPanel, NodePath, acrylic_window)
+DEFINE_PROPERTY_SET(AcrylicSettingsPanel, NodePath&, acrylic_window)
+
+#pragma endregion
+
+AcrylicWindow* AcrylicSettingsPanel::get_window() const {
+	return Object::cast_to<AcrylicWindow>(get_node_or_null(acrylic_window));
+}
+
+void AcrylicSettingsPanel::add_row(int row) {
+	Label* label = memnew(Label);
+	monitor_node(label);
+	label->set_text(ROWS[row].label);
+	add_child(label);
+
+	Control* control = nullptr;
+
+	switch (ROWS[row].type) {
+	case ROW_SLIDER: {
+		HSlider* slider = memnew(HSlider);
+		slider->set_min(ROWS[row].min);
+		slider->set_max(ROWS[row].max);
+		slider->set_step(ROWS[row].step);
+		slider->set_ticks_on_borders(true);
+		control = slider;
+
+		// Preview text size while dragging and relayout only once when released.
+		if (row == ROW_TEXT_SIZE) {
+			slider->connect("drag_started", callable_mp(this, &AcrylicSettingsPanel::on_text_size_drag_started));
+			slider->connect("drag_ended", callable_mp(this, &AcrylicSettingsPanel::on_text_size_drag_ended));
+		}
+	} break;
+
+	case ROW_CHECK:
+		control = memnew(CheckButton);
+		break;
+
+	case ROW_OPTION: {
+		ScrollableOptionButton* option_button = memnew(ScrollableOptionButton);
+		PackedStringArray items = String(ROWS[row].items).split(",");
+		for (const String& item : items)
+			option_button->add_item(item);
+		control = option_button;
+	} break;
+
+	case ROW_COLOR:
+		control = memnew(ColorPickerButton);
+		control->set_custom_minimum_size(Vector2(100, 0));
+		break;
+	}
+
+	monitor_node(control);
+	add_child(control);
+	binder->bind(ROWS[row].property, control, CONTROL_PROPERTIES[ROWS[row].type]);
+
+	labels.push_back(label);
+	controls.push_back(control);
+}
+
+void AcrylicSettingsPanel::on_auto_colors_changed(bool auto_colors) {
+	for (int row = ROW_FIRST_DERIVED_COLOR; row < ROW_COUNT; row++) {
+		labels[row]->set_visible(!auto_colors);
+		controls[row]->set_visible(!auto_colors);
+	}
+}
+
+void AcrylicSettingsPanel::on_text_color_changed(const Color& text_color) {
+	Ref<Theme> theme = get_theme();
+	if (theme.is_valid())
+		theme->set_color("font_color", "Label", text_color);
+}
+
+void AcrylicSettingsPanel::on_preset_selected(int64_t index) {
+	set_preset(static_cast<Preset>(index));
+}
+
+void AcrylicSettingsPanel::on_text_size_drag_started() {
+	AcrylicWindow* window = get_window();
+	if (window)
+		window->begin_style_update();
+}
+
+void AcrylicSettingsPanel::on_text_size_drag_ended(bool) {
+	AcrylicWindow* window = get_window();
+	if (window)
+		window->end_style_update();
+}
+
+}
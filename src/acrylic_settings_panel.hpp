@@ -0,0 +1,100 @@
+/**************************************************************************/
+/*  acrylic_settings_panel.hpp                                            */
+/*  Settings of AcrylicWindow built the first time they are shown.        */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "helpers.hpp"
+
+#include <godot_cpp/classes/grid_container.hpp>
+
+#include <vector>
+
+namespace godot {
+
+class AcrylicBinder;
+class AcrylicWindow;
+class Control;
+class Label;
+class OptionButton;
+
+// EXAMPLES
+// var panel := AcrylicSettingsPanel.new()
+// panel.acrylic_window = window.get_path()
+// panel.hide()
+// add_child(panel) # Cheap: no controls yet.
+// ...
+// panel.show() # Builds the controls.
+//
+// The panel is an empty GridContainer until it's visible in the tree.
+// Presets can be applied before that because they only touch the window.
+class AcrylicSettingsPanel : public GridContainer {
+	GDCLASS(AcrylicSettingsPanel, GridContainer)
+
+public:
+	enum Preset {
+		PRESET_ACRYLIC_AMETHYST,
+		PRESET_ACRYLIC_GLASS,
+		PRESET_ACRYLIC_BLUE,
+		PRESET_ACRYLIC_FAINT_BLUE,
+		PRESET_ACRYLIC_RED,
+		PRESET_ACRYLIC_GREEN,
+		PRESET_ACRYLIC_GRAY,
+		PRESET_ACRYLIC_BLACK,
+		PRESET_ACRYLIC_WHITE,
+		PRESET_MICA_BLUE,
+		PRESET_MICA_RED,
+		PRESET_MICA_GREEN,
+		PRESET_MICA_GRAY,
+		PRESET_MICA_BLACK,
+		PRESET_MICA_WHITE,
+		PRESET_MAX
+	};
+
+public:
+	DECLARE_PROPERTY(NodePath&, acrylic_window, NodePath(".."))
+
+public:
+	void set_preset(Preset preset);
+
+	// Builds the controls now instead of the first time the panel is shown.
+	void build();
+	bool is_built() const;
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+private:
+	AcrylicWindow* get_window() const;
+
+	void add_row(int row);
+
+	void on_auto_colors_changed(bool auto_colors);
+	void on_text_color_changed(const Color& text_color);
+	void on_preset_selected(int64_t index);
+	void on_text_size_drag_started();
+	void on_text_size_drag_ended(bool value_changed);
+
+private:
+	bool built = false;
+	Preset preset = PRESET_MAX;
+
+	AcrylicBinder* binder = nullptr;
+	OptionButton* preset_button = nullptr;
+	// One label and one control per row of ROWS.
+	std::vector<Label*> labels;
+	std::vector<Control*> controls;
+};
+
+}
+
+VARIANT_ENUM_CAST(::godot::AcrylicSettingsPanel::Preset)
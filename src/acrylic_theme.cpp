@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  acrylic_theme.cpp                                                     */
+/*  Style shared by many AcrylicWindows.                                  */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "acrylic_theme.hpp"
+
+#include "helpers.hpp"
+#include "core/style.hpp"
+#include "trace.hpp"
+
+#include <godot_cpp/core/object.hpp>
+
+#include <algorithm>
+
+namespace {
+	constexpr char PRINT_CATEGORY[] = "AcrylicTheme";
+}
+
+// Every edit is applied to the subscribers at the end of the frame.
+#define DEFINE_THEME_PROPERTY_SET(property_type, property_name) \
+	void AcrylicTheme::set_##property_name(const property_type p_##property_name) { \
+		if (property_name == p_##property_name) \
+			return; \
+		property_name = p_##property_name; \
+		queue_update(); \
+	}
+
+namespace godot {
+
+void AcrylicTheme::_bind_methods() {
+	BIND_PROPERTY_ENUM(AcrylicTheme, Variant::INT, backdrop, "Solid, Transparent, Acrylic, Mica, Tabbed");
+	BIND_PROPERTY_ENUM(AcrylicTheme, Variant::INT, corner, "Default, Don't Round, Round, Round Small");
+
+	BIND_PROPERTY(AcrylicTheme, Variant::BOOL, auto_colors);
+	BIND_PROPERTY(AcrylicTheme, Variant::COLOR, base_color);
+	BIND_PROPERTY(AcrylicTheme, Variant::COLOR, border_color);
+	BIND_PROPERTY(AcrylicTheme, Variant::COLOR, title_bar_color);
+	BIND_PROPERTY(AcrylicTheme, Variant::COLOR, text_color);
+	BIND_PROPERTY(AcrylicTheme, Variant::COLOR, clear_color);
+}
+
+const Color& AcrylicTheme::get_style_border_color() {
+	update_style_colors();
+	return style_border_color;
+}
+
+const Color& AcrylicTheme::get_style_title_bar_color() {
+	update_style_colors();
+	return style_title_bar_color;
+}
+
+const Color& AcrylicTheme::get_style_text_color() {
+	update_style_colors();
+	return style_text_color;
+}
+
+const Color& AcrylicTheme::get_style_clear_color() {
+	update_style_colors();
+	return style_clear_color;
+}
+
+void AcrylicTheme::subscribe(AcrylicWindow* window) {
+	uint64_t instance_id = window->get_instance_id();
+	if (std::find(subscribers.begin(), subscribers.end(), instance_id) == subscribers.end())
+		subscribers.push_back(instance_id);
+}
+
+void AcrylicTheme::unsubscribe(AcrylicWindow* window) {
+	uint64_t instance_id = window->get_instance_id();
+	auto subscriber = std::find(subscribers.begin(), subscribers.end(), instance_id);
+	if (subscriber == subscribers.end())
+		return;
+
+	*subscriber = subscribers.back();
+	subscribers.pop_back();
+}
+
+void AcrylicTheme::queue_update() {
+	style_colors_dirty = true;
+
+	if (update_queued)
+		return;
+
+	update_queued = true;
+	callable_mp(this, &AcrylicTheme::update).call_deferred();
+}
+
+void AcrylicTheme::update() {
+	TRACE_SCOPE("AcrylicTheme::update");
+
+	update_queued = false;
+	update_style_colors();
+
+	// Windows may unsubscribe while being updated, so iterate over a copy.
+	std::vector<uint64_t> windows = subscribers;
+	for (uint64_t instance_id : windows) {
+		AcrylicWindow* window = Object::cast_to<AcrylicWindow>(ObjectDB::get_instance(instance_id));
+		if (!window) {
+			print_debug("Removing a deleted subscriber.");
+			subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), instance_id), subscribers.end());
+			continue;
+		}
+
+		window->apply_theme();
+	}
+
+	emit_changed();
+}
+
+void AcrylicTheme::update_style_colors() {
+	if (!style_colors_dirty)
+		return;
+
+	style_colors_dirty = false;
+
+	if (!auto_colors) {
+		style_border_color = border_color;
+		style_title_bar_color = title_bar_color;
+		style_text_color = text_color;
+		style_clear_color = clear_color;
+		return;
+	}
+
+	acrylic::StyleColors colors = acrylic::adjust_colors(to_rgba(base_color));
+	style_border_color = to_color(colors.border_color);
+	style_title_bar_color = to_color(colors.title_bar_color);
+	style_text_color = to_color(colors.text_color);
+	style_clear_color = to_color(colors.clear_color);
+}
+
+#pragma region PROPERTIES
+
+DEFINE_PROPERTY_GET(AcrylicTheme, AcrylicWindow::Backdrop, backdrop)
+DEFINE_PROPERTY_GET(AcrylicTheme, AcrylicWindow::Corner, corner)
+DEFINE_PROPERTY_GET(AcrylicTheme, bool, auto_colors)
+DEFINE_PROPERTY_GET(AcrylicTheme, Color, base_color)
+DEFINE_PROPERTY_GET(AcrylicTheme, Color, border_color)
+DEFINE_PROPERTY_GET(AcrylicTheme, Color, title_bar_color)
+DEFINE_PROPERTY_GET(AcrylicTheme, Color, text_color)
+DEFINE_PROPERTY_GET(AcrylicTheme, Color, clear_color)
+
+DEFINE_THEME_PROPERTY_SET(AcrylicWindow::Backdrop, backdrop)
+DEFINE_THEME_PROPERTY_SET(AcrylicWindow::Corner, corner)
+DEFINE_THEME_PROPERTY_SET(bool, auto_colors)
+DEFINE_THEME_PROPERTY_SET(Color&, base_color)
+DEFINE_THEME_PROPERTY_SET(Color&, border_color)
+DEFINE_THEME_PROPERTY_SET(Color&, title_bar_color)
+DEFINE_THEME_PROPERTY_SET(Color&, text_color)
+DEFINE_THEME_PROPERTY_SET(Color&, clear_color)
+
+#pragma endregion
+
+}
@@ -0,0 +1,80 @@
+/**************************************************************************/
+/*  acrylic_theme.hpp                                                     */
+/*  Style shared by many AcrylicWindows.                                  */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "acrylic_window.hpp"
+
+#include <godot_cpp/classes/resource.hpp>
+
+#include <vector>
+
+namespace godot {
+
+// EXAMPLES
+// var theme := preload("res://dark.tres") as AcrylicTheme
+// for window in windows:
+//     window.acrylic_theme = theme
+// theme.base_color = Color.DARK_SLATE_GRAY # Updates all the windows at the end of the frame.
+//
+// Edits are batched: the colors are derived once and the subscribed windows
+// are updated in one pass at the end of the frame no matter how many
+// properties have been changed. Windows keep their own values for the
+// properties listed in AcrylicWindow.theme_overrides.
+class AcrylicTheme : public Resource {
+	GDCLASS(AcrylicTheme, Resource)
+
+public:
+	DECLARE_PROPERTY(AcrylicWindow::Backdrop, backdrop, AcrylicWindow::BACKDROP_ACRYLIC)
+	DECLARE_PROPERTY(AcrylicWindow::Corner, corner, AcrylicWindow::CORNER_DEFAULT)
+
+	// Automatically adjust colors based on the base_color.
+	DECLARE_PROPERTY(bool, auto_colors, true)
+	DECLARE_PROPERTY(Color&, base_color, Color(0.133, 0.145, 0.149, 0.741))
+	DECLARE_PROPERTY(Color&, border_color, Color(0, 0, 0))
+	DECLARE_PROPERTY(Color&, title_bar_color, Color(0, 0, 0))
+	DECLARE_PROPERTY(Color&, text_color, Color(1, 1, 1))
+	DECLARE_PROPERTY(Color&, clear_color, Color(0, 0, 0))
+
+public:
+	// Colors after auto_colors has been applied.
+	const Color& get_style_border_color();
+	const Color& get_style_title_bar_color();
+	const Color& get_style_text_color();
+	const Color& get_style_clear_color();
+
+public:
+	void subscribe(AcrylicWindow* window);
+	void unsubscribe(AcrylicWindow* window);
+
+protected:
+	static void _bind_methods();
+
+private:
+	void queue_update();
+	void update();
+	void update_style_colors();
+
+private:
+	Color style_border_color = Color(0, 0, 0);
+	Color style_title_bar_color = Color(0, 0, 0);
+	Color style_text_color = Color(1, 1, 1);
+	Color style_clear_color = Color(0, 0, 0);
+
+	bool style_colors_dirty = true;
+	bool update_queued = false;
+
+	// Instance ids of the subscribed windows.
+	std::vector<uint64_t> subscribers;
+};
+
+}
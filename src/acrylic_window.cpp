@@ -12,17 +12,75 @@
 
 #include "acrylic_window.hpp"
 
+#include "acrylic_theme.hpp"
 #include "helpers.hpp"
 #include "native_window.hpp"
+#include "screen_scales.hpp"
+#include "startup.hpp"
+#include "core/region.hpp"
+#include "core/style.hpp"
+#include "core/window_registry.hpp"
+#include "trace.hpp"
 
 #include <godot_cpp/classes/button.hpp>
 #include <godot_cpp/classes/color_rect.hpp>
+#include <godot_cpp/classes/display_server.hpp>
+#include <godot_cpp/classes/input_event.hpp>
 #include <godot_cpp/classes/label.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/popup.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/time.hpp>
 
 #include <godot_cpp/classes/window.hpp>
+#include <godot_cpp/core/object.hpp>
+
+#include <algorithm>
 
 namespace {
-	const char PRINT_CATEGORY[] = "AcrylicWindow";
+	constexpr char PRINT_CATEGORY[] = "AcrylicWindow";
+
+	// Instance ids of AcrylicWindows by window id. Touched only on the main thread.
+	acrylic::WindowRegistry<uint64_t> instances;
+
+	// Size changes closer in time than this belong to one burst.
+	constexpr uint64_t SIZE_BURST_INTERVAL = 100000; // usec
+	constexpr int SIZE_BURST_COUNT = 3;
+
+	// A live resize that has no native end finishes after this pause in size changes.
+	constexpr uint64_t LIVE_RESIZE_TIMEOUT = 250000; // usec
+
+	constexpr char OPAQUE_GROUP[] = "acrylic_opaque";
+	// base_color with this alpha or more makes the whole window opaque.
+	constexpr float OPAQUE_ALPHA = 254.5f / 255.0f;
+
+	// Window signals that render a frame with on_demand_rendering.
+	constexpr const char* WINDOW_CHANGED_SIGNALS[] = { "mouse_entered", "mouse_exited", "focus_entered", "focus_exited" };
+
+	// Window pixels covered by the control. inward keeps only the pixels that
+	// are covered entirely, otherwise partly covered ones are included too.
+	acrylic::Rect to_pixel_rect(godot::Control* control, const godot::Transform2D& to_pixels, bool inward) {
+		godot::Rect2 rect = (to_pixels * control->get_global_transform_with_canvas()).xform(godot::Rect2(godot::Point2(), control->get_size()));
+		godot::Vector2 end = rect.get_end();
+
+		if (inward) {
+			return {
+				static_cast<int32_t>(godot::Math::ceil(rect.position.x)),
+				static_cast<int32_t>(godot::Math::ceil(rect.position.y)),
+				static_cast<int32_t>(godot::Math::floor(end.x)),
+				static_cast<int32_t>(godot::Math::floor(end.y))
+			};
+		}
+
+		return {
+			static_cast<int32_t>(godot::Math::floor(rect.position.x)),
+			static_cast<int32_t>(godot::Math::floor(rect.position.y)),
+			static_cast<int32_t>(godot::Math::ceil(end.x)),
+			static_cast<int32_t>(godot::Math::ceil(end.y))
+		};
+	}
 }
 
 // Check that property has been modified and that node is ready.
@@ -48,8 +106,111 @@ namespace {
 		return;											\
 	}
 
+// Style properties: X(type, name, variant_type, hint, hint_string, has_signal).
+// The table generates their bindings and drives get_style/set_style.
+// set_style emits the *_changed signals in this order.
+#define ACRYLIC_WINDOW_STYLE(X)																						\
+	X(float, text_size, FLOAT, PROPERTY_HINT_NONE, "", true)														\
+	X(AcrylicWindow::Rescale, rescale_mode, INT, PROPERTY_HINT_ENUM, "Immediate, Debounced", false)				\
+	X(float, rescale_delay, FLOAT, PROPERTY_HINT_NONE, "", false)													\
+	X(bool, auto_text_size, BOOL, PROPERTY_HINT_NONE, "", true)													\
+	X(bool, always_on_top, BOOL, PROPERTY_HINT_NONE, "", true)														\
+	X(bool, drag_by_content, BOOL, PROPERTY_HINT_NONE, "", true)													\
+	X(bool, drag_by_right_click, BOOL, PROPERTY_HINT_NONE, "", true)												\
+	X(float, dim_strength, FLOAT, PROPERTY_HINT_NONE, "", true)													\
+	X(float, live_resize_rate, FLOAT, PROPERTY_HINT_NONE, "", false)												\
+	X(float, live_resize_render_scale, FLOAT, PROPERTY_HINT_NONE, "", false)										\
+	X(AcrylicWindow::Frame, frame, INT, PROPERTY_HINT_ENUM, "Default, Borderless, Custom", true)					\
+	X(AcrylicWindow::Backdrop, backdrop, INT, PROPERTY_HINT_ENUM, "Solid, Transparent, Acrylic, Mica, Tabbed", true)	\
+	X(AcrylicWindow::Corner, corner, INT, PROPERTY_HINT_ENUM, "Default, Don't Round, Round, Round Small", true)		\
+	X(AcrylicWindow::Autohide, autohide_title_bar, INT, PROPERTY_HINT_ENUM, "Never, Always, Maximized", true)		\
+	X(AcrylicWindow::Accent, accent_title_bar, INT, PROPERTY_HINT_ENUM, "Never, Always, Mouse Over", true)			\
+	X(bool, auto_colors, BOOL, PROPERTY_HINT_NONE, "", true)														\
+	X(Color, base_color, COLOR, PROPERTY_HINT_NONE, "", true)														\
+	X(Color, border_color, COLOR, PROPERTY_HINT_NONE, "", true)													\
+	X(Color, title_bar_color, COLOR, PROPERTY_HINT_NONE, "", true)													\
+	X(Color, text_color, COLOR, PROPERTY_HINT_NONE, "", true)														\
+	X(Color, clear_color, COLOR, PROPERTY_HINT_NONE, "", true)
+
+namespace {
+	using godot::PropertyHint;
+	using godot::Variant;
+
+	struct StyleProperty {
+		const char* name;
+		Variant::Type type;
+		// Number of values of an enum property, 0 for the others.
+		int64_t enum_size;
+		bool has_signal;
+	};
+
+	constexpr int64_t count_enum_values(PropertyHint hint, const char* hint_string) {
+		if (hint != godot::PROPERTY_HINT_ENUM)
+			return 0;
+
+		int64_t count = 1;
+		for (; *hint_string; hint_string++) {
+			if (*hint_string == ',')
+				count++;
+		}
+
+		return count;
+	}
+
+#define STYLE_PROPERTY_INDEX(type, name, variant_type, hint, hint_string, has_signal) \
+	STYLE_PROPERTY_##name,
+
+	enum StylePropertyIndex {
+		ACRYLIC_WINDOW_STYLE(STYLE_PROPERTY_INDEX)
+		STYLE_PROPERTY_MAX
+	};
+
+#undef STYLE_PROPERTY_INDEX
+
+#define STYLE_PROPERTY_DESCRIPTOR(type, name, variant_type, hint, hint_string, has_signal) \
+	{ #name, Variant::variant_type, count_enum_values(godot::hint, hint_string), has_signal },
+
+	constexpr StyleProperty STYLE_PROPERTIES[STYLE_PROPERTY_MAX] = {
+		ACRYLIC_WINDOW_STYLE(STYLE_PROPERTY_DESCRIPTOR)
+	};
+
+#undef STYLE_PROPERTY_DESCRIPTOR
+
+	// Returns -1 if there is no such style property.
+	int find_style_property(const godot::String& name) {
+		for (int i = 0; i < STYLE_PROPERTY_MAX; i++) {
+			if (name == STYLE_PROPERTIES[i].name)
+				return i;
+		}
+
+		return -1;
+	}
+
+	bool is_valid_style_value(const StyleProperty& property, const Variant& value) {
+		Variant::Type type = value.get_type();
+
+		// Numbers from GDScript and JSON may come as either type.
+		bool is_number = type == Variant::INT || type == Variant::FLOAT;
+		if (property.type == Variant::FLOAT)
+			return is_number;
+
+		if (type != property.type)
+			return false;
+
+		if (property.enum_size) {
+			int64_t index = value;
+			return index >= 0 && index < property.enum_size;
+		}
+
+		return true;
+	}
+}
+
 namespace godot {
 
+AcrylicWindow::~AcrylicWindow()
+{}
+
 void AcrylicWindow::minimize() {
 	NATIVE_GUARD;
 	native.minimize();
@@ -75,6 +236,7 @@ void AcrylicWindow::dim(bool on) {
 	}
 
 	dim_tween = create_tween();
+	monitor_tween(dim_tween.ptr());
 
 	bool should_dim = on && dim_strength > 0.0001 && !always_on_top;
 
@@ -92,6 +254,283 @@ void AcrylicWindow::dim(bool on) {
 	}
 }
 
+void AcrylicWindow::begin_style_update() {
+	style_updates++;
+}
+
+void AcrylicWindow::end_style_update() {
+	if (style_updates == 0) {
+		print_warning("end_style_update is called without begin_style_update.");
+		return;
+	}
+
+	style_updates--;
+	if (style_updates == 0 && previewing_text_size)
+		commit_text_size();
+}
+
+Dictionary AcrylicWindow::get_style() const {
+	Dictionary style;
+
+#define GET_STYLE_PROPERTY(type, name, variant_type, hint, hint_string, has_signal) \
+	style[#name] = name;
+
+	ACRYLIC_WINDOW_STYLE(GET_STYLE_PROPERTY)
+
+#undef GET_STYLE_PROPERTY
+
+	return style;
+}
+
+bool AcrylicWindow::set_style(const Dictionary& style) {
+	TRACE_SCOPE("AcrylicWindow::set_style");
+
+	// Validate everything first so that an invalid style changes nothing.
+	Variant values[STYLE_PROPERTY_MAX];
+	bool has_values[STYLE_PROPERTY_MAX] = {};
+
+	Array keys = style.keys();
+	for (int64_t i = 0; i < keys.size(); i++) {
+		String name = keys[i];
+		int index = find_style_property(name);
+		if (index < 0) {
+			print_error("Unknown style property %s.", name.utf8().get_data());
+			return false;
+		}
+
+		const Variant& value = style[keys[i]];
+		if (!is_valid_style_value(STYLE_PROPERTIES[index], value)) {
+			print_error("Invalid value %s of style property %s.", value.stringify().utf8().get_data(), name.utf8().get_data());
+			return false;
+		}
+
+		values[index] = value;
+		has_values[index] = true;
+	}
+
+#define SAVE_STYLE_PROPERTY(type, name, variant_type, hint, hint_string, has_signal) \
+	const type previous_##name = name;
+
+#define SET_STYLE_PROPERTY(type, name, variant_type, hint, hint_string, has_signal) \
+	if (has_values[STYLE_PROPERTY_##name])											\
+		name = VariantCaster<type>::cast(values[STYLE_PROPERTY_##name]);
+
+#define EMIT_STYLE_PROPERTY(type, name, variant_type, hint, hint_string, has_signal) \
+	if (has_signal && name != previous_##name)										\
+		EMIT_SIGNAL_CHANGED(name);
+
+	ACRYLIC_WINDOW_STYLE(SAVE_STYLE_PROPERTY)
+	ACRYLIC_WINDOW_STYLE(SET_STYLE_PROPERTY)
+
+	// Same as set_frame: a given frame is applied even if it's the default.
+	if (has_values[STYLE_PROPERTY_frame])
+		frame_set = true;
+
+	// Same as the setters: derived colors replace the given ones.
+	if (auto_colors)
+		adjust_colors();
+
+	if (auto_text_size != previous_auto_text_size) {
+		current_screen = -1;
+		screen_scale = 1;
+	}
+
+	// One pass over the native window instead of one per property.
+	if (is_node_ready()) {
+		apply_style();
+		queue_redraw();
+		queue_region_update();
+	}
+
+	ACRYLIC_WINDOW_STYLE(EMIT_STYLE_PROPERTY)
+
+#undef SAVE_STYLE_PROPERTY
+#undef SET_STYLE_PROPERTY
+#undef EMIT_STYLE_PROPERTY
+
+	return true;
+}
+
+void AcrylicWindow::queue_region_update() {
+	// The layout has changed.
+	request_frame();
+
+	if (region_update_queued || is_editor())
+		return;
+
+	region_update_queued = true;
+	callable_mp(this, &AcrylicWindow::update_regions).call_deferred();
+}
+
+void AcrylicWindow::request_frame() {
+	frame_requested = true;
+
+	// Render this iteration if it hasn't been drawn yet.
+	if (on_demand_active)
+		set_render_loop_enabled(true);
+}
+
+int64_t AcrylicWindow::get_rendered_frames() const {
+	return rendered_frames;
+}
+
+int64_t AcrylicWindow::get_skipped_frames() const {
+	return skipped_frames;
+}
+
+const acrylic::HitTestBuffer& AcrylicWindow::get_hit_test_buffer() const {
+	return hit_test_buffer;
+}
+
+void AcrylicWindow::start_resize(DisplayServer::WindowResizeEdge edge) {
+	Window* window = get_window();
+	if (!window) {
+		print_error("Failed to get window.");
+		return;
+	}
+
+	// On Windows this call returns when the resize is over.
+	begin_live_resize();
+	window->start_resize(edge);
+}
+
+void AcrylicWindow::begin_live_resize(bool until_ended) {
+	if (live_resizing) {
+		live_resize_until_ended = live_resize_until_ended || until_ended;
+		return;
+	}
+
+	if (!is_node_ready() || is_editor())
+		return;
+
+	TRACE_SCOPE("AcrylicWindow::begin_live_resize");
+
+	live_resizing = true;
+	live_resize_until_ended = until_ended;
+	live_resize_layout_pending = false;
+	live_resize_last_change = Time::get_singleton()->get_ticks_usec();
+	live_resize_last_layout = live_resize_last_change;
+
+	// With all the anchors at the top left the window size doesn't affect
+	// the layout. The rect is kept and is resized in process_live_resize.
+	for (int side = 0; side < 4; side++) {
+		live_resize_anchors[side] = get_anchor(static_cast<Side>(side));
+		live_resize_offsets[side] = get_offset(static_cast<Side>(side));
+	}
+
+	for (int side = 0; side < 4; side++)
+		set_anchor(static_cast<Side>(side), 0, false, false);
+
+	Window* window = get_window();
+	live_resize_reduced = window && live_resize_render_scale < 1;
+	if (live_resize_reduced) {
+		live_resize_msaa_2d = window->get_msaa_2d();
+		live_resize_scaling_3d_scale = window->get_scaling_3d_scale();
+		window->set_msaa_2d(Viewport::MSAA_DISABLED);
+		window->set_scaling_3d_scale(live_resize_scaling_3d_scale * live_resize_render_scale);
+	}
+
+	update_processing();
+
+	monitor_signal_emitted();
+	emit_signal("live_resize_started");
+}
+
+void AcrylicWindow::end_live_resize() {
+	if (!live_resizing)
+		return;
+
+	TRACE_SCOPE("AcrylicWindow::end_live_resize");
+
+	live_resizing = false;
+	live_resize_until_ended = false;
+	live_resize_layout_pending = false;
+	size_changes = 0;
+
+	// One full layout at the final size. Godot clamps a left or top anchor
+	// to the opposite one, which is still 0, so right and bottom go first.
+	const Side sides[] = { SIDE_RIGHT, SIDE_BOTTOM, SIDE_LEFT, SIDE_TOP };
+	for (Side side : sides) {
+		set_anchor(side, live_resize_anchors[side], true, false);
+		set_offset(side, live_resize_offsets[side]);
+	}
+
+	Window* window = get_window();
+	if (window && live_resize_reduced) {
+		window->set_msaa_2d(live_resize_msaa_2d);
+		window->set_scaling_3d_scale(live_resize_scaling_3d_scale);
+	}
+
+	live_resize_reduced = false;
+
+	update_processing();
+	queue_redraw();
+
+	monitor_signal_emitted();
+	emit_signal("live_resize_ended");
+}
+
+bool AcrylicWindow::is_live_resizing() const {
+	return live_resizing;
+}
+
+bool AcrylicWindow::start_trace() {
+	if (!trace_start()) {
+		print_warning("Trace is already running.");
+		return false;
+	}
+
+	return true;
+}
+
+bool AcrylicWindow::stop_trace(const String& path) {
+	if (!trace_is_running()) {
+		print_warning("Trace is not running.");
+		return false;
+	}
+
+	ProjectSettings* project_settings = ProjectSettings::get_singleton();
+	if (!project_settings) {
+		print_error("Failed to get project settings.");
+		return false;
+	}
+
+	String global_path = project_settings->globalize_path(path);
+	if (!trace_stop(global_path.utf8().get_data())) {
+		print_error("Failed to write trace to %s.", global_path.utf8().get_data());
+		return false;
+	}
+
+	return true;
+}
+
+bool AcrylicWindow::start_message_recording(const String& path) {
+	ProjectSettings* project_settings = ProjectSettings::get_singleton();
+	if (!project_settings) {
+		print_error("Failed to get project settings.");
+		return false;
+	}
+
+	String global_path = project_settings->globalize_path(path);
+	return NativeWindow::start_message_recording(global_path.utf8().get_data());
+}
+
+bool AcrylicWindow::stop_message_recording() {
+	return NativeWindow::stop_message_recording();
+}
+
+Dictionary AcrylicWindow::get_startup_timings() {
+	return ::godot::get_startup_timings();
+}
+
+AcrylicWindow* AcrylicWindow::find_by_window_id(int32_t window_id) {
+	const uint64_t* instance_id = instances.find(static_cast<uint64_t>(window_id));
+	if (!instance_id)
+		return nullptr;
+
+	return Object::cast_to<AcrylicWindow>(ObjectDB::get_instance(*instance_id));
+}
+
 void AcrylicWindow::_ready() {
 	// NOTE: This function is called twice in the editor: when opening a scene 
 	// in the editor and when loading a scene in a game running in the editor.
@@ -113,6 +552,23 @@ void AcrylicWindow::_notification(int p_what) {
 	case NOTIFICATION_EXIT_TREE:
 		on_exit_tree();
 		break;
+	case NOTIFICATION_PROCESS:
+		on_process();
+		break;
+	case NOTIFICATION_WM_DPI_CHANGE:
+		invalidate_screen_scales();
+		on_screen_changed();
+		break;
+	case NOTIFICATION_WM_POSITION_CHANGED:
+		on_screen_changed();
+		break;
+	case NOTIFICATION_WM_WINDOW_FOCUS_IN:
+		on_window_focus_in();
+		break;
+	case NOTIFICATION_PREDELETE:
+		if (acrylic_theme.is_valid())
+			acrylic_theme->unsubscribe(this);
+		break;
 	}
 }
 
@@ -140,30 +596,60 @@ void AcrylicWindow::_bind_methods() {
 	BIND_ENUM_CONSTANT(AUTOHIDE_ALWAYS);
 	BIND_ENUM_CONSTANT(AUTOHIDE_MAXIMIZED);
 
+	BIND_ENUM_CONSTANT(RESCALE_IMMEDIATE);
+	BIND_ENUM_CONSTANT(RESCALE_DEBOUNCED);
+
+	BIND_ENUM_CONSTANT(THEME_OVERRIDE_BACKDROP);
+	BIND_ENUM_CONSTANT(THEME_OVERRIDE_CORNER);
+	BIND_ENUM_CONSTANT(THEME_OVERRIDE_AUTO_COLORS);
+	BIND_ENUM_CONSTANT(THEME_OVERRIDE_BASE_COLOR);
+	BIND_ENUM_CONSTANT(THEME_OVERRIDE_BORDER_COLOR);
+	BIND_ENUM_CONSTANT(THEME_OVERRIDE_TITLE_BAR_COLOR);
+	BIND_ENUM_CONSTANT(THEME_OVERRIDE_TEXT_COLOR);
+	BIND_ENUM_CONSTANT(THEME_OVERRIDE_CLEAR_COLOR);
+
 	BIND_PROPERTY(AcrylicWindow, Variant::BOOL, modify_editor);
+	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::BOOL, mouse_passthrough);
+	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::BOOL, on_demand_rendering);
+	BIND_PROPERTY(AcrylicWindow, Variant::FLOAT, on_demand_idle_rate);
 
-	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::FLOAT, text_size);
-	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::BOOL, always_on_top);
-	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::BOOL, drag_by_content);
-	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::BOOL, drag_by_right_click);
-	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::FLOAT, dim_strength);
-	
-	BIND_PROPERTY_ENUM_AND_SIGNAL(AcrylicWindow, Variant::INT, frame, "Default, Borderless, Custom");
-	BIND_PROPERTY_ENUM_AND_SIGNAL(AcrylicWindow, Variant::INT, backdrop, "Solid, Transparent, Acrylic, Mica, Tabbed");
-	BIND_PROPERTY_ENUM_AND_SIGNAL(AcrylicWindow, Variant::INT, corner, "Default, Don't Round, Round, Round Small");
-	BIND_PROPERTY_ENUM_AND_SIGNAL(AcrylicWindow, Variant::INT, autohide_title_bar, "Never, Always, Maximized");
-	BIND_PROPERTY_ENUM_AND_SIGNAL(AcrylicWindow, Variant::INT, accent_title_bar, "Never, Always, Mouse Over");
-
-	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::BOOL, auto_colors);
-	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::COLOR, base_color);
-	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::COLOR, border_color);
-	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::COLOR, title_bar_color);
-	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::COLOR, text_color);
-	BIND_PROPERTY_AND_SIGNAL(AcrylicWindow, Variant::COLOR, clear_color);
+#define BIND_STYLE_PROPERTY(type, name, variant_type, hint, hint_string, has_signal)							\
+	BIND_PROPERTY_HINT(AcrylicWindow, Variant::variant_type, name, hint, hint_string)							\
+	if (has_signal)																								\
+		ADD_SIGNAL(MethodInfo(#name"_changed", PropertyInfo(Variant::variant_type, "new_"#name)));
+
+	ACRYLIC_WINDOW_STYLE(BIND_STYLE_PROPERTY)
+
+#undef BIND_STYLE_PROPERTY
+
+	BIND_PROPERTY_HINT_AND_SIGNAL(AcrylicWindow, Variant::OBJECT, acrylic_theme, PROPERTY_HINT_RESOURCE_TYPE, "AcrylicTheme");
+	BIND_PROPERTY_HINT(AcrylicWindow, Variant::INT, theme_overrides, PROPERTY_HINT_FLAGS, "Backdrop,Corner,Auto Colors,Base Color,Border Color,Title Bar Color,Text Color,Clear Color");
 
 	BIND_FUNCTION(AcrylicWindow, minimize);
 	BIND_FUNCTION(AcrylicWindow, maximize);
 	BIND_FUNCTION(AcrylicWindow, close);
+	BIND_FUNCTION(AcrylicWindow, begin_style_update);
+	BIND_FUNCTION(AcrylicWindow, end_style_update);
+	BIND_FUNCTION(AcrylicWindow, queue_region_update);
+	BIND_FUNCTION(AcrylicWindow, request_frame);
+	BIND_FUNCTION(AcrylicWindow, get_rendered_frames);
+	BIND_FUNCTION(AcrylicWindow, get_skipped_frames);
+	BIND_FUNCTION(AcrylicWindow, get_style);
+	BIND_FUNCTION(AcrylicWindow, set_style, "style");
+	BIND_FUNCTION(AcrylicWindow, start_resize, "edge");
+	ClassDB::bind_method(D_METHOD("begin_live_resize", "until_ended"), &AcrylicWindow::begin_live_resize, DEFVAL(false));
+	BIND_FUNCTION(AcrylicWindow, end_live_resize);
+	BIND_FUNCTION(AcrylicWindow, is_live_resizing);
+
+	ADD_SIGNAL(MethodInfo("live_resize_started"));
+	ADD_SIGNAL(MethodInfo("live_resize_ended"));
+
+	ClassDB::bind_static_method("AcrylicWindow", D_METHOD("start_trace"), &AcrylicWindow::start_trace);
+	ClassDB::bind_static_method("AcrylicWindow", D_METHOD("stop_trace", "path"), &AcrylicWindow::stop_trace);
+	ClassDB::bind_static_method("AcrylicWindow", D_METHOD("start_message_recording", "path"), &AcrylicWindow::start_message_recording);
+	ClassDB::bind_static_method("AcrylicWindow", D_METHOD("stop_message_recording"), &AcrylicWindow::stop_message_recording);
+	ClassDB::bind_static_method("AcrylicWindow", D_METHOD("get_startup_timings"), &AcrylicWindow::get_startup_timings);
+	ClassDB::bind_static_method("AcrylicWindow", D_METHOD("find_by_window_id", "window_id"), &AcrylicWindow::find_by_window_id);
 }
 
 #pragma region CALLBACKS
@@ -196,42 +682,208 @@ void AcrylicWindow::on_ready() {
 	NATIVE_GUARD;
 	native.on_ready();
 
-	dim_rect = memnew(ColorRect);
-	dim_rect->set_name("DimRect");
-	dim_rect->set_color(Color(0, 0, 0, 0));
-	dim_rect->set_mouse_filter(Control::MOUSE_FILTER_IGNORE);
-	dim_rect->set_z_index(100);
-	dim_rect->set_anchor_and_offset(SIDE_LEFT, 0, 0);
-	dim_rect->set_anchor_and_offset(SIDE_RIGHT, 1, 0);
-	dim_rect->set_anchor_and_offset(SIDE_TOP, 0, 0);
-	dim_rect->set_anchor_and_offset(SIDE_BOTTOM, 1, 0);
-	add_child(dim_rect);
+	Window* window = get_window();
+	if (window && !window->is_embedded()) {
+		int32_t window_id = window->get_window_id();
+		if (instances.insert(static_cast<uint64_t>(window_id), get_instance_id()))
+			registered_window_id = window_id;
+		else
+			print_error("Window %d already has an AcrylicWindow.", window_id);
+	}
+
+	if (window) {
+		window->connect("size_changed", callable_mp(this, &AcrylicWindow::on_window_size_changed));
+		window_mode = int(window->get_mode());
+	}
+
+	// The child stays when the window leaves the tree and is readied again.
+	if (!dim_rect) {
+		dim_rect = memnew(ColorRect);
+		monitor_node(dim_rect);
+		dim_rect->set_name("DimRect");
+		dim_rect->set_color(Color(0, 0, 0, 0));
+		dim_rect->set_mouse_filter(Control::MOUSE_FILTER_IGNORE);
+		dim_rect->set_z_index(100);
+		dim_rect->set_anchor_and_offset(SIDE_LEFT, 0, 0);
+		dim_rect->set_anchor_and_offset(SIDE_RIGHT, 1, 0);
+		dim_rect->set_anchor_and_offset(SIDE_TOP, 0, 0);
+		dim_rect->set_anchor_and_offset(SIDE_BOTTOM, 1, 0);
+		add_child(dim_rect);
+	}
 
 	//dim(true);
 
 	// Need this to drag by content.
 	set_mouse_filter(MOUSE_FILTER_PASS);
 	apply_style();
+	queue_region_update();
+
+	if (on_demand_rendering)
+		start_on_demand_rendering();
 }
 
 void AcrylicWindow::on_exit_tree() {
 	if (is_editor())
 		return;
 
+	if (registered_window_id != DisplayServer::INVALID_WINDOW_ID) {
+		instances.erase(static_cast<uint64_t>(registered_window_id));
+		registered_window_id = DisplayServer::INVALID_WINDOW_ID;
+	}
+
+	// Don't leave the window zoomed.
+	if (previewing_text_size)
+		commit_text_size();
+
+	end_live_resize();
+
+	Window* window = get_window();
+	Callable on_size_changed = callable_mp(this, &AcrylicWindow::on_window_size_changed);
+	if (window && window->is_connected("size_changed", on_size_changed))
+		window->disconnect("size_changed", on_size_changed);
+
+	watch_tree(false);
+	stop_on_demand_rendering();
+
+	// Everything above is set up again by on_ready on the next enter.
+	request_ready();
+
 	NATIVE_GUARD;
 	native.on_exit_tree();
 }
 
+void AcrylicWindow::on_process() {
+	uint64_t now = Time::get_singleton()->get_ticks_usec();
+
+	if (previewing_text_size && style_updates == 0 && now >= text_size_deadline)
+		commit_text_size();
+
+	if (live_resizing)
+		process_live_resize(now);
+
+	if (checking_hit_test)
+		check_mouse_region();
+}
+
+// Every size change relayouts the whole tree. Bursts of them are an
+// interactive resize even if the platform doesn't report it.
+void AcrylicWindow::on_window_size_changed() {
+	uint64_t now = Time::get_singleton()->get_ticks_usec();
+
+	queue_region_update();
+	update_window_mode();
+
+	if (live_resizing) {
+		live_resize_last_change = now;
+		live_resize_layout_pending = true;
+		return;
+	}
+
+	if (now - last_size_change > SIZE_BURST_INTERVAL)
+		size_changes = 0;
+
+	last_size_change = now;
+	if (++size_changes >= SIZE_BURST_COUNT)
+		begin_live_resize();
+}
+
+// Mode changes come with size changes: maximize, minimize and fullscreen.
+void AcrylicWindow::update_window_mode() {
+	Window* window = get_window();
+	if (!window || window_mode == int(window->get_mode()))
+		return;
+
+	window_mode = int(window->get_mode());
+	if (is_editor())
+		return;
+
+	NATIVE_GUARD;
+	native.on_mode_changed();
+}
+
+void AcrylicWindow::on_window_focus_in() {
+	if (!is_node_ready() || is_editor())
+		return;
+
+	NATIVE_GUARD;
+	native.on_focus_in();
+}
+
+void AcrylicWindow::process_live_resize(uint64_t now) {
+	uint64_t interval = live_resize_rate > 0 ? static_cast<uint64_t>(1000000 / live_resize_rate) : 0;
+
+	if (live_resize_layout_pending && now - live_resize_last_layout >= interval) {
+		TRACE_SCOPE("AcrylicWindow::live_resize_layout");
+
+		// The size the saved anchors and offsets would give.
+		Vector2 parent_size = get_parent_area_size();
+		set_size(Vector2(
+			parent_size.x * (live_resize_anchors[SIDE_RIGHT] - live_resize_anchors[SIDE_LEFT]) + live_resize_offsets[SIDE_RIGHT] - live_resize_offsets[SIDE_LEFT],
+			parent_size.y * (live_resize_anchors[SIDE_BOTTOM] - live_resize_anchors[SIDE_TOP]) + live_resize_offsets[SIDE_BOTTOM] - live_resize_offsets[SIDE_TOP]));
+
+		live_resize_layout_pending = false;
+		live_resize_last_layout = now;
+	}
+
+	if (!live_resize_until_ended && now - live_resize_last_change >= LIVE_RESIZE_TIMEOUT)
+		end_live_resize();
+}
+
+void AcrylicWindow::on_screen_changed() {
+	if (!is_node_ready() || is_editor())
+		return;
+
+	if (update_screen_scale())
+		commit_text_size(true);
+}
+
+// Cheap unless the window has moved to another screen.
+// Returns true if the scale has changed.
+bool AcrylicWindow::update_screen_scale() {
+	if (!auto_text_size)
+		return false;
+
+	Window* window = get_window();
+	if (!window)
+		return false;
+
+	// Invalidated scales may have changed for the same screen index.
+	int screen = window->get_current_screen();
+	uint32_t generation = get_screen_scales_generation();
+	if (screen == current_screen && generation == current_screen_generation)
+		return false;
+
+	current_screen = screen;
+	current_screen_generation = generation;
+
+	float new_screen_scale = get_screen_scale(screen);
+	if (new_screen_scale == screen_scale)
+		return false;
+
+	print_debug("The window has moved to screen %d with scale %.2f.", screen, new_screen_scale);
+	screen_scale = new_screen_scale;
+
+	return true;
+}
+
 #pragma endregion
 
 #pragma region PROPERTIES
 
 DEFINE_PROPERTY_GET(AcrylicWindow, float, text_size)
+DEFINE_PROPERTY_GET(AcrylicWindow, AcrylicWindow::Rescale, rescale_mode)
+DEFINE_PROPERTY_GET(AcrylicWindow, float, rescale_delay)
+DEFINE_PROPERTY_GET(AcrylicWindow, bool, auto_text_size)
 DEFINE_PROPERTY_GET(AcrylicWindow, bool, always_on_top)
 DEFINE_PROPERTY_GET(AcrylicWindow, bool, drag_by_content)
 DEFINE_PROPERTY_GET(AcrylicWindow, bool, drag_by_right_click)
 DEFINE_PROPERTY_GET(AcrylicWindow, float, dim_strength)
+DEFINE_PROPERTY_GET(AcrylicWindow, float, live_resize_rate)
+DEFINE_PROPERTY_GET(AcrylicWindow, float, live_resize_render_scale)
 DEFINE_PROPERTY_GET(AcrylicWindow, bool, modify_editor)
+DEFINE_PROPERTY_GET(AcrylicWindow, bool, mouse_passthrough)
+DEFINE_PROPERTY_GET(AcrylicWindow, bool, on_demand_rendering)
+DEFINE_PROPERTY_GET(AcrylicWindow, float, on_demand_idle_rate)
 DEFINE_PROPERTY_GET(AcrylicWindow, AcrylicWindow::Frame, frame)
 DEFINE_PROPERTY_GET(AcrylicWindow, AcrylicWindow::Backdrop, backdrop)
 DEFINE_PROPERTY_GET(AcrylicWindow, AcrylicWindow::Corner, corner)
@@ -243,10 +895,14 @@ DEFINE_PROPERTY_GET(AcrylicWindow, Color, border_color)
 DEFINE_PROPERTY_GET(AcrylicWindow, Color, title_bar_color)
 DEFINE_PROPERTY_GET(AcrylicWindow, Color, text_color)
 DEFINE_PROPERTY_GET(AcrylicWindow, Color, clear_color)
+DEFINE_PROPERTY_GET(AcrylicWindow, Ref<AcrylicTheme>, acrylic_theme)
+DEFINE_PROPERTY_GET(AcrylicWindow, int64_t, theme_overrides)
 
-DEFINE_PROPERTY_SET(AcrylicWindow, bool, drag_by_content)
-DEFINE_PROPERTY_SET(AcrylicWindow, bool, drag_by_right_click)
-DEFINE_PROPERTY_SET(AcrylicWindow, float, dim_strength)
+DEFINE_PROPERTY_SET(AcrylicWindow, float, live_resize_rate)
+DEFINE_PROPERTY_SET(AcrylicWindow, float, live_resize_render_scale)
+DEFINE_PROPERTY_SET(AcrylicWindow, float, on_demand_idle_rate)
+DEFINE_PROPERTY_SET(AcrylicWindow, AcrylicWindow::Rescale, rescale_mode)
+DEFINE_PROPERTY_SET(AcrylicWindow, float, rescale_delay)
 
 void AcrylicWindow::set_modify_editor(const bool p_modify_editor) {
 	PROPERTY_GUARD(modify_editor);
@@ -255,6 +911,55 @@ void AcrylicWindow::set_modify_editor(const bool p_modify_editor) {
 		apply_style();
 }
 
+// Native hit tests read these from the snapshot.
+void AcrylicWindow::set_drag_by_content(const bool p_drag_by_content) {
+	PROPERTY_GUARD(drag_by_content);
+
+	drag_by_content = p_drag_by_content;
+	queue_region_update();
+
+	EMIT_SIGNAL_CHANGED(drag_by_content);
+}
+
+void AcrylicWindow::set_drag_by_right_click(const bool p_drag_by_right_click) {
+	PROPERTY_GUARD(drag_by_right_click);
+
+	drag_by_right_click = p_drag_by_right_click;
+	queue_region_update();
+
+	EMIT_SIGNAL_CHANGED(drag_by_right_click);
+}
+
+// Takes effect on the next dim.
+void AcrylicWindow::set_dim_strength(const float p_dim_strength) {
+	PROPERTY_GUARD(dim_strength);
+
+	dim_strength = p_dim_strength;
+
+	EMIT_SIGNAL_CHANGED(dim_strength);
+}
+
+void AcrylicWindow::set_mouse_passthrough(const bool p_mouse_passthrough) {
+	PROPERTY_GUARD(mouse_passthrough);
+
+	mouse_passthrough = p_mouse_passthrough;
+	queue_region_update();
+
+	EMIT_SIGNAL_CHANGED(mouse_passthrough);
+}
+
+void AcrylicWindow::set_on_demand_rendering(const bool p_on_demand_rendering) {
+	PROPERTY_GUARD(on_demand_rendering);
+
+	on_demand_rendering = p_on_demand_rendering;
+	if (on_demand_rendering)
+		start_on_demand_rendering();
+	else
+		stop_on_demand_rendering();
+
+	EMIT_SIGNAL_CHANGED(on_demand_rendering);
+}
+
 void AcrylicWindow::set_text_size(const float p_text_size) {
 	PROPERTY_GUARD(text_size);
 		
@@ -263,13 +968,28 @@ void AcrylicWindow::set_text_size(const float p_text_size) {
 		return;
 	}
 
-	NATIVE_GUARD;
-	if (!native.set_text_size(p_text_size))
-		return;
-
 	text_size = p_text_size;
 
-	EMIT_SIGNAL_CHANGED(text_size);
+	if (rescale_mode == RESCALE_DEBOUNCED || style_updates > 0)
+		preview_text_size();
+	else
+		commit_text_size();
+}
+
+void AcrylicWindow::set_auto_text_size(const bool p_auto_text_size) {
+	PROPERTY_GUARD(auto_text_size);
+
+	auto_text_size = p_auto_text_size;
+	current_screen = -1;
+	screen_scale = 1;
+
+	EMIT_SIGNAL_CHANGED(auto_text_size);
+
+	if (is_editor())
+		return;
+
+	update_screen_scale();
+	commit_text_size(true);
 }
 
 void AcrylicWindow::set_always_on_top(const bool p_always_on_top) {
@@ -289,7 +1009,15 @@ void AcrylicWindow::set_always_on_top(const bool p_always_on_top) {
 }
 
 void AcrylicWindow::set_frame(const AcrylicWindow::Frame p_frame) {
-	PROPERTY_GUARD(frame);
+	// The first set is applied even if frame doesn't change, see frame_set.
+	bool first_set = !frame_set;
+	frame_set = true;
+	if (!first_set) {
+		PROPERTY_GUARD(frame);
+	} else if (!is_node_ready()) {
+		frame = p_frame;
+		return;
+	}
 	EDITOR_GUARD(frame);
 
 	// Need to set frame first because wndproc calls get_frame.
@@ -304,7 +1032,8 @@ void AcrylicWindow::set_frame(const AcrylicWindow::Frame p_frame) {
 
 	frame = p_frame;
 
-	EMIT_SIGNAL_CHANGED(frame);
+	if (frame != prev_frame)
+		EMIT_SIGNAL_CHANGED(frame);
 }
 
 void AcrylicWindow::set_backdrop(const AcrylicWindow::Backdrop p_backdrop) {
@@ -316,6 +1045,7 @@ void AcrylicWindow::set_backdrop(const AcrylicWindow::Backdrop p_backdrop) {
 		return;
 
 	backdrop = p_backdrop;
+	queue_region_update();
 
 	EMIT_SIGNAL_CHANGED(backdrop);
 }
@@ -375,6 +1105,7 @@ void AcrylicWindow::set_base_color(const Color &p_base_color) {
 
 	base_color = p_base_color;
 	queue_redraw();
+	queue_region_update();
 
 	EMIT_SIGNAL_CHANGED(base_color);
 
@@ -461,16 +1192,494 @@ void AcrylicWindow::set_clear_color(const Color &p_clear_color) {
 	EMIT_SIGNAL_CHANGED(clear_color);
 }
 
+void AcrylicWindow::set_acrylic_theme(const Ref<AcrylicTheme>& p_acrylic_theme) {
+	if (acrylic_theme == p_acrylic_theme)
+		return;
+
+	if (acrylic_theme.is_valid())
+		acrylic_theme->unsubscribe(this);
+
+	acrylic_theme = p_acrylic_theme;
+
+	if (acrylic_theme.is_valid()) {
+		acrylic_theme->subscribe(this);
+		apply_theme();
+	}
+
+	EMIT_SIGNAL_CHANGED(acrylic_theme);
+}
+
+void AcrylicWindow::set_theme_overrides(const int64_t p_theme_overrides) {
+	if (theme_overrides == p_theme_overrides)
+		return;
+
+	// The properties that are no longer overridden get the values of the theme.
+	theme_overrides = p_theme_overrides;
+	apply_theme();
+}
+
+// Zooms the current layout instead of relayouting it at the new content scale.
+void AcrylicWindow::preview_text_size() {
+	TRACE_SCOPE("AcrylicWindow::preview_text_size");
+
+	Window* window = get_window();
+	if (!window || committed_text_size <= 0) {
+		commit_text_size();
+		return;
+	}
+
+	if (!previewing_text_size) {
+		canvas_transform = window->get_global_canvas_transform();
+		previewing_text_size = true;
+	}
+
+	float ratio = text_size / committed_text_size;
+	window->set_global_canvas_transform(canvas_transform.scaled(Vector2(ratio, ratio)));
+
+	if (style_updates == 0) {
+		text_size_deadline = Time::get_singleton()->get_ticks_usec() + static_cast<uint64_t>(rescale_delay * 1000000);
+		update_processing();
+	}
+}
+
+void AcrylicWindow::commit_text_size(bool force) {
+	TRACE_SCOPE("AcrylicWindow::commit_text_size");
+
+	reset_text_size_preview();
+
+	bool changed = text_size != committed_text_size;
+	if (!changed && !force)
+		return;
+
+	NATIVE_GUARD;
+	if (!native.set_text_size(get_content_scale(text_size))) {
+		text_size = committed_text_size;
+		return;
+	}
+
+	committed_text_size = text_size;
+
+	if (changed) {
+		queue_region_update();
+		EMIT_SIGNAL_CHANGED(text_size);
+	}
+}
+
+void AcrylicWindow::reset_text_size_preview() {
+	if (!previewing_text_size)
+		return;
+
+	previewing_text_size = false;
+	update_processing();
+
+	Window* window = get_window();
+	if (window)
+		window->set_global_canvas_transform(canvas_transform);
+}
+
+float AcrylicWindow::get_content_scale(float p_text_size) const {
+	return auto_text_size ? p_text_size * screen_scale : p_text_size;
+}
+
+// The text_size preview and live resize share processing.
+void AcrylicWindow::update_processing() {
+	set_process(previewing_text_size || live_resizing || checking_hit_test);
+}
+
+void AcrylicWindow::update_regions() {
+	region_update_queued = false;
+	if (!is_inside_tree())
+		return;
+
+	TRACE_SCOPE("AcrylicWindow::update_regions");
+
+	NATIVE_GUARD;
+
+	Window* window = get_window();
+	Vector2i size = window->get_size();
+	acrylic::Rect bounds = { 0, 0, size.x, size.y };
+
+	// Canvas to window pixels, including the content scale of text_size.
+	Transform2D to_pixels = window->get_final_transform();
+
+	// Controls that stop the mouse, for mouse_passthrough and native hit tests.
+	bool has_hit_test = native.has_hit_test();
+	bool needs_mouse_region = mouse_passthrough || has_hit_test;
+	watch_tree(needs_mouse_region);
+
+	std::vector<acrylic::Rect> mouse_region;
+	bool has_popup = false;
+	if (needs_mouse_region) {
+		std::vector<acrylic::Rect> rects;
+		add_mouse_rects(window, bounds, to_pixels, &rects, &has_popup);
+		mouse_region = acrylic::merge_rects(rects);
+	}
+
+	if (has_hit_test)
+		publish_hit_test(mouse_region, has_popup);
+
+	if (checking_hit_test != has_hit_test) {
+		checking_hit_test = has_hit_test;
+		update_processing();
+	}
+
+	update_mouse_passthrough(mouse_region);
+
+	if (!native.has_regions())
+		return;
+
+	std::vector<acrylic::Rect> opaque_region;
+	bool opaque = backdrop == BACKDROP_SOLID || base_color.a >= OPAQUE_ALPHA;
+	if (opaque) {
+		opaque_region.push_back(bounds);
+	}
+	else {
+		std::vector<acrylic::Rect> rects;
+
+		TypedArray<Node> nodes = get_tree()->get_nodes_in_group(OPAQUE_GROUP);
+		for (int64_t i = 0; i < nodes.size(); i++) {
+			Control* control = Object::cast_to<Control>(nodes[i]);
+			if (!control || control->get_window() != window)
+				continue;
+
+			watch_node(control);
+			if (!control->is_visible_in_tree())
+				continue;
+
+			// Round inwards so that no translucent pixel is reported as opaque.
+			acrylic::Rect pixels = acrylic::intersect(to_pixel_rect(control, to_pixels, true), bounds);
+			if (!acrylic::is_empty(pixels))
+				rects.push_back(pixels);
+		}
+
+		opaque_region = acrylic::merge_rects(rects);
+	}
+
+	// Blur only where the backdrop shows through.
+	bool blur = !opaque && backdrop >= BACKDROP_ACRYLIC;
+	std::vector<acrylic::Rect> blur_region;
+	if (blur)
+		blur_region = acrylic::subtract_rects(bounds, opaque_region);
+
+	native.set_regions(opaque_region, blur, blur_region);
+}
+
+void AcrylicWindow::update_mouse_passthrough(const std::vector<acrylic::Rect>& mouse_region) {
+	std::vector<acrylic::Point> polygon;
+	if (mouse_passthrough) {
+		polygon = acrylic::join_outlines(acrylic::get_outlines(mouse_region));
+
+		// An empty polygon turns passthrough off. Nothing gets the mouse
+		// with a polygon of no area.
+		if (polygon.empty())
+			polygon.assign(3, acrylic::Point());
+	}
+
+	// Layout changes that don't move the mouse rects cost nothing native.
+	if (polygon == mouse_passthrough_polygon)
+		return;
+
+	NATIVE_GUARD;
+	if (native.set_mouse_passthrough(polygon))
+		mouse_passthrough_polygon = std::move(polygon);
+}
+
+void AcrylicWindow::publish_hit_test(const std::vector<acrylic::Rect>& mouse_region, bool has_popup) {
+	// Most updates don't touch the mouse rects, so readers keep their snapshot.
+	bool unchanged = false;
+	hit_test_buffer.read([&](const acrylic::HitTestSnapshot& published) {
+		unchanged = published.generation != 0 && published.has_popup == has_popup
+			&& published.drag_by_content == drag_by_content && published.drag_by_right_click == drag_by_right_click
+			&& published.blocking_region == mouse_region;
+	});
+
+	if (unchanged)
+		return;
+
+	acrylic::HitTestSnapshot& snapshot = hit_test_buffer.begin_write();
+	snapshot.blocking_region = mouse_region;
+	snapshot.has_popup = has_popup;
+	snapshot.drag_by_content = drag_by_content;
+	snapshot.drag_by_right_click = drag_by_right_click;
+	hit_test_buffer.publish();
+}
+
+// Walks the tree like update_regions, which runs only if the rects differ
+// from the published ones.
+void AcrylicWindow::check_mouse_region() {
+	if (region_update_queued || !is_inside_tree())
+		return;
+
+	TRACE_SCOPE("AcrylicWindow::check_mouse_region");
+
+	Window* window = get_window();
+	Vector2i size = window->get_size();
+	acrylic::Rect bounds = { 0, 0, size.x, size.y };
+
+	std::vector<acrylic::Rect> rects;
+	bool has_popup = false;
+	add_mouse_rects(window, bounds, window->get_final_transform(), &rects, &has_popup);
+	std::vector<acrylic::Rect> mouse_region = acrylic::merge_rects(rects);
+
+	bool changed = false;
+	hit_test_buffer.read([&](const acrylic::HitTestSnapshot& published) {
+		changed = published.has_popup != has_popup || published.blocking_region != mouse_region;
+	});
+
+	if (changed)
+		queue_region_update();
+}
+
+void AcrylicWindow::add_mouse_rects(Node* node, const acrylic::Rect& bounds, const Transform2D& to_pixels, std::vector<acrylic::Rect>* rects, bool* has_popup) {
+	// Internal children too: scroll bars stop the mouse and popup menus of buttons are internal.
+	for (int64_t i = 0; i < node->get_child_count(true); i++) {
+		Node* child = node->get_child(i, true);
+
+		// Open popups take the clicks outside them to close.
+		Popup* popup = Object::cast_to<Popup>(child);
+		if (popup) {
+			watch_node(popup);
+			if (popup->is_visible())
+				*has_popup = true;
+			continue;
+		}
+
+		// Sub-windows handle the mouse themselves.
+		if (Object::cast_to<Window>(child))
+			continue;
+
+		CanvasItem* item = Object::cast_to<CanvasItem>(child);
+		Control* control = Object::cast_to<Control>(child);
+
+		// Parents move their children without changing the children rects,
+		// so every control is watched and not only the ones that stop the mouse.
+		if (control)
+			watch_node(control);
+
+		if (item && !item->is_visible())
+			continue;
+
+		if (control && control->get_mouse_filter() == MOUSE_FILTER_STOP) {
+			// Round outwards so that no pixel of the control misses a click.
+			acrylic::Rect pixels = acrylic::intersect(to_pixel_rect(control, to_pixels, false), bounds);
+			if (!acrylic::is_empty(pixels))
+				rects->push_back(pixels);
+		}
+
+		add_mouse_rects(child, bounds, to_pixels, rects, has_popup);
+	}
+}
+
+void AcrylicWindow::watch_node(Node* node) {
+	Callable on_changed = callable_mp(this, &AcrylicWindow::queue_region_update);
+	if (node->is_connected("visibility_changed", on_changed))
+		return;
+
+	node->connect("visibility_changed", on_changed);
+	// Popups have no item_rect_changed.
+	if (Object::cast_to<Control>(node))
+		node->connect("item_rect_changed", on_changed);
+}
+
+// Controls and popups added or removed under the window change the mouse region.
+void AcrylicWindow::watch_tree(bool watch) {
+	SceneTree* tree = get_tree();
+	if (!tree)
+		return;
+
+	Callable on_changed = callable_mp(this, &AcrylicWindow::on_tree_node_changed);
+	if (tree->is_connected("node_added", on_changed) == watch)
+		return;
+
+	if (watch) {
+		tree->connect("node_added", on_changed);
+		tree->connect("node_removed", on_changed);
+	}
+	else {
+		tree->disconnect("node_added", on_changed);
+		tree->disconnect("node_removed", on_changed);
+	}
+}
+
+void AcrylicWindow::on_tree_node_changed(Node* node) {
+	if (!Object::cast_to<Control>(node) && !Object::cast_to<Popup>(node))
+		return;
+
+	Window* window = get_window();
+	if (window && window->is_ancestor_of(node))
+		queue_region_update();
+}
+
+void AcrylicWindow::start_on_demand_rendering() {
+	if (on_demand_active || is_editor())
+		return;
+
+	SceneTree* tree = get_tree();
+	Window* window = get_window();
+	if (!tree || !window) {
+		print_error("Failed to get scene tree.");
+		return;
+	}
+
+	if (tree->get_root() != window) {
+		print_warning("on_demand_rendering is only supported by the AcrylicWindow of the main window.");
+		return;
+	}
+
+	OS* os = OS::get_singleton();
+	RenderingServer* rendering_server = RenderingServer::get_singleton();
+	if (!os || !rendering_server) {
+		print_error("Failed to get OS or rendering server.");
+		return;
+	}
+
+	TRACE_SCOPE("AcrylicWindow::start_on_demand_rendering");
+
+	previous_low_processor_mode = os->is_in_low_processor_usage_mode();
+	previous_low_processor_sleep = os->get_low_processor_usage_mode_sleep_usec();
+	os->set_low_processor_usage_mode(true);
+
+	tree->connect("process_frame", callable_mp(this, &AcrylicWindow::on_process_frame));
+	rendering_server->connect("frame_post_draw", callable_mp(this, &AcrylicWindow::on_frame_post_draw));
+
+	Callable on_window_changed = callable_mp(this, &AcrylicWindow::request_frame);
+	window->connect("window_input", callable_mp(this, &AcrylicWindow::on_window_input));
+	for (const char* signal : WINDOW_CHANGED_SIGNALS)
+		window->connect(signal, on_window_changed);
+
+	Callable on_style_changed = callable_mp(this, &AcrylicWindow::on_style_changed);
+	for (const StyleProperty& property : STYLE_PROPERTIES) {
+		if (property.has_signal)
+			connect(String(property.name) + "_changed", on_style_changed);
+	}
+
+	on_demand_active = true;
+	counting_frames = false;
+	rendered_frames = 0;
+	skipped_frames = 0;
+	request_frame();
+}
+
+void AcrylicWindow::stop_on_demand_rendering() {
+	if (!on_demand_active)
+		return;
+
+	TRACE_SCOPE("AcrylicWindow::stop_on_demand_rendering");
+
+	on_demand_active = false;
+
+	SceneTree* tree = get_tree();
+	Callable on_process_frame = callable_mp(this, &AcrylicWindow::on_process_frame);
+	if (tree && tree->is_connected("process_frame", on_process_frame))
+		tree->disconnect("process_frame", on_process_frame);
+
+	RenderingServer* rendering_server = RenderingServer::get_singleton();
+	if (rendering_server) {
+		Callable on_frame_post_draw = callable_mp(this, &AcrylicWindow::on_frame_post_draw);
+		if (rendering_server->is_connected("frame_post_draw", on_frame_post_draw))
+			rendering_server->disconnect("frame_post_draw", on_frame_post_draw);
+
+		rendering_server->set_render_loop_enabled(true);
+	}
+
+	render_loop_enabled = true;
+
+	Window* window = get_window();
+	if (window) {
+		Callable on_window_input = callable_mp(this, &AcrylicWindow::on_window_input);
+		if (window->is_connected("window_input", on_window_input))
+			window->disconnect("window_input", on_window_input);
+
+		Callable on_window_changed = callable_mp(this, &AcrylicWindow::request_frame);
+		for (const char* signal : WINDOW_CHANGED_SIGNALS) {
+			if (window->is_connected(signal, on_window_changed))
+				window->disconnect(signal, on_window_changed);
+		}
+	}
+
+	Callable on_style_changed = callable_mp(this, &AcrylicWindow::on_style_changed);
+	for (const StyleProperty& property : STYLE_PROPERTIES) {
+		String signal = String(property.name) + "_changed";
+		if (property.has_signal && is_connected(signal, on_style_changed))
+			disconnect(signal, on_style_changed);
+	}
+
+	OS* os = OS::get_singleton();
+	if (os) {
+		os->set_low_processor_usage_mode(previous_low_processor_mode);
+		os->set_low_processor_usage_mode_sleep_usec(previous_low_processor_sleep);
+	}
+}
+
+// Decides at the start of every iteration whether it's rendered.
+void AcrylicWindow::on_process_frame() {
+	// The previous iteration has been drawn or skipped by now.
+	if (counting_frames) {
+		bool drawn = frame_drawn.exchange(false, std::memory_order_relaxed);
+		if (drawn)
+			rendered_frames++;
+		else
+			skipped_frames++;
+
+		monitor_frame(drawn);
+	}
+
+	counting_frames = true;
+	frame_drawn.store(false, std::memory_order_relaxed);
+
+	// Tweens animate for many frames after the input that started them.
+	// Godot doesn't tell which node a tween animates, so any running tween
+	// of the tree counts, including the ones of other windows.
+	bool dirty = frame_requested;
+	if (!dirty) {
+		TypedArray<Tween> tweens = get_tree()->get_processed_tweens();
+		for (int64_t i = 0; i < tweens.size() && !dirty; i++) {
+			Tween* tween = Object::cast_to<Tween>(tweens[i]);
+			dirty = tween && tween->is_running();
+		}
+	}
+
+	frame_requested = false;
+
+	set_render_loop_enabled(dirty);
+}
+
+// Idle iterations sleep longer. The sleep of the project is used while rendering.
+void AcrylicWindow::set_render_loop_enabled(bool enabled) {
+	if (render_loop_enabled == enabled)
+		return;
+
+	render_loop_enabled = enabled;
+	RenderingServer::get_singleton()->set_render_loop_enabled(enabled);
+
+	int64_t idle_sleep = on_demand_idle_rate > 0 ? static_cast<int64_t>(1000000 / on_demand_idle_rate) : 0;
+	OS::get_singleton()->set_low_processor_usage_mode_sleep_usec(enabled ? previous_low_processor_sleep : std::max(idle_sleep, previous_low_processor_sleep));
+}
+
+void AcrylicWindow::on_frame_post_draw() {
+	frame_drawn.store(true, std::memory_order_relaxed);
+}
+
+void AcrylicWindow::on_window_input(const Ref<InputEvent>&) {
+	request_frame();
+}
+
+void AcrylicWindow::on_style_changed(const Variant&) {
+	request_frame();
+}
+
 void AcrylicWindow::adjust_colors() {
-	float luminance = base_color.get_luminance();
-	Color border_tint = Color(luminance, luminance, luminance) * 0.75;
-	border_color = base_color.lerp(border_tint, 1 - base_color.a);
-	title_bar_color = border_color;
-	text_color = luminance < 0.65 ? Color(1, 1, 1) : Color(0, 0, 0);
-	clear_color = base_color.darkened(0.85);
+	acrylic::StyleColors colors = acrylic::adjust_colors(to_rgba(base_color));
+	border_color = to_color(colors.border_color);
+	title_bar_color = to_color(colors.title_bar_color);
+	text_color = to_color(colors.text_color);
+	clear_color = to_color(colors.clear_color);
 }
 
 void AcrylicWindow::apply_style() {
+	TRACE_SCOPE("AcrylicWindow::apply_style");
+	ApplyStyleMonitorScope monitor_scope;
+
 	if (is_editor()) {
 		if (!modify_editor)
 			return;
@@ -479,7 +1688,11 @@ void AcrylicWindow::apply_style() {
 	}
 
 	NATIVE_GUARD;
-	native.set_text_size(text_size);
+	reset_text_size_preview();
+	current_screen = -1;
+	update_screen_scale();
+	if (native.set_text_size(get_content_scale(text_size)))
+		committed_text_size = text_size;
 	native.set_always_on_top(always_on_top);
 	native.set_backdrop(backdrop);
 	native.set_corner(corner);
@@ -488,6 +1701,87 @@ void AcrylicWindow::apply_style() {
 	native.set_text_color(text_color);
 	native.set_clear_color(clear_color);
 	native.set_frame(frame);
+
+	startup_mark_styled();
+}
+
+void AcrylicWindow::apply_theme() {
+	TRACE_SCOPE("AcrylicWindow::apply_theme");
+
+	if (acrylic_theme.is_null())
+		return;
+
+	AcrylicTheme* theme = acrylic_theme.ptr();
+	auto is_overridden = [this](ThemeOverride property) {
+		return (theme_overrides & property) != 0;
+	};
+
+	Backdrop new_backdrop = is_overridden(THEME_OVERRIDE_BACKDROP) ? backdrop : theme->get_backdrop();
+	Corner new_corner = is_overridden(THEME_OVERRIDE_CORNER) ? corner : theme->get_corner();
+	bool new_auto_colors = is_overridden(THEME_OVERRIDE_AUTO_COLORS) ? auto_colors : theme->get_auto_colors();
+	Color new_base_color = is_overridden(THEME_OVERRIDE_BASE_COLOR) ? base_color : theme->get_base_color();
+
+	Color new_border_color;
+	Color new_title_bar_color;
+	Color new_text_color;
+	Color new_clear_color;
+
+	if (new_auto_colors && (!theme->get_auto_colors() || new_base_color != theme->get_base_color())) {
+		// The window has its own base color, so the colors of the theme don't apply.
+		acrylic::StyleColors colors = acrylic::adjust_colors(to_rgba(new_base_color));
+		new_border_color = to_color(colors.border_color);
+		new_title_bar_color = to_color(colors.title_bar_color);
+		new_text_color = to_color(colors.text_color);
+		new_clear_color = to_color(colors.clear_color);
+	}
+	else {
+		// Reuse the colors that the theme has derived once for all the windows.
+		bool keep_own = !new_auto_colors;
+		new_border_color = keep_own && is_overridden(THEME_OVERRIDE_BORDER_COLOR) ? border_color : theme->get_style_border_color();
+		new_title_bar_color = keep_own && is_overridden(THEME_OVERRIDE_TITLE_BAR_COLOR) ? title_bar_color : theme->get_style_title_bar_color();
+		new_text_color = keep_own && is_overridden(THEME_OVERRIDE_TEXT_COLOR) ? text_color : theme->get_style_text_color();
+		new_clear_color = keep_own && is_overridden(THEME_OVERRIDE_CLEAR_COLOR) ? clear_color : theme->get_style_clear_color();
+	}
+
+	if (!is_node_ready() || (is_editor() && !modify_editor)) {
+		backdrop = new_backdrop;
+		corner = new_corner;
+		auto_colors = new_auto_colors;
+		base_color = new_base_color;
+		border_color = new_border_color;
+		title_bar_color = new_title_bar_color;
+		text_color = new_text_color;
+		clear_color = new_clear_color;
+		queue_redraw();
+		return;
+	}
+
+	bool redraw = new_backdrop != backdrop || new_base_color != base_color;
+
+	NATIVE_GUARD;
+
+	// Only the properties that have actually changed reach the native window and emit signals.
+#define APPLY_THEME_PROPERTY(property_name)											\
+	if (new_##property_name != property_name && native.set_##property_name(new_##property_name)) {	\
+		property_name = new_##property_name;										\
+		EMIT_SIGNAL_CHANGED(property_name);											\
+	}
+
+	APPLY_THEME_PROPERTY(backdrop)
+	APPLY_THEME_PROPERTY(corner)
+	APPLY_THEME_PROPERTY(auto_colors)
+	APPLY_THEME_PROPERTY(base_color)
+	APPLY_THEME_PROPERTY(border_color)
+	APPLY_THEME_PROPERTY(title_bar_color)
+	APPLY_THEME_PROPERTY(text_color)
+	APPLY_THEME_PROPERTY(clear_color)
+
+#undef APPLY_THEME_PROPERTY
+
+	if (redraw) {
+		queue_redraw();
+		queue_region_update();
+	}
 }
 
 #pragma endregion
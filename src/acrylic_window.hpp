@@ -13,19 +13,29 @@
 #pragma once
 
 #include "helpers.hpp"
+#include "core/geometry.hpp"
+#include "core/hit_test.hpp"
 
 #include <godot_cpp/classes/control.hpp>
+#include <godot_cpp/classes/display_server.hpp>
+#include <godot_cpp/classes/viewport.hpp>
 #include <godot_cpp/classes/tween.hpp>
 #include <godot_cpp/classes/property_tweener.hpp>
 
+#include <atomic>
+#include <vector>
+
 namespace godot {
 
+class AcrylicTheme;
 class ColorRect;
+class InputEvent;
 //class Tween;
 
 class AcrylicWindow : public Control {
 	GDCLASS(AcrylicWindow, Control)
 
+	friend class AcrylicTheme;
 	friend class NativeWindow;
 
 public:
@@ -62,16 +72,61 @@ public:
 		ACCENT_MOUSE_OVER		
 	};
 
+	enum Rescale {
+		// Apply text_size right away.
+		RESCALE_IMMEDIATE,
+		// Zoom the current layout while text_size keeps changing and apply it
+		// after rescale_delay seconds without changes or on end_style_update.
+		RESCALE_DEBOUNCED
+	};
+
+	// Properties that keep the value of the window when it has an acrylic_theme.
+	enum ThemeOverride {
+		THEME_OVERRIDE_BACKDROP = 1 << 0,
+		THEME_OVERRIDE_CORNER = 1 << 1,
+		THEME_OVERRIDE_AUTO_COLORS = 1 << 2,
+		THEME_OVERRIDE_BASE_COLOR = 1 << 3,
+		THEME_OVERRIDE_BORDER_COLOR = 1 << 4,
+		THEME_OVERRIDE_TITLE_BAR_COLOR = 1 << 5,
+		THEME_OVERRIDE_TEXT_COLOR = 1 << 6,
+		THEME_OVERRIDE_CLEAR_COLOR = 1 << 7
+	};
+
 public:
 	/* EXPERIMENTAL If enabled, allows to modify the editor a bit. */
 	DECLARE_PROPERTY(bool, modify_editor, false)
 
 	DECLARE_PROPERTY(float, text_size, 1.25)
+	DECLARE_PROPERTY(Rescale, rescale_mode, RESCALE_IMMEDIATE)
+	DECLARE_PROPERTY(float, rescale_delay, 0.3)
+	// Multiply text_size by the scale of the screen the window is on
+	// (1 at 96 DPI, 1.5 at 144 DPI and so on).
+	DECLARE_PROPERTY(bool, auto_text_size, false)
 	DECLARE_PROPERTY(bool, always_on_top, true)
 	DECLARE_PROPERTY(bool, drag_by_content, true)
 	DECLARE_PROPERTY(bool, drag_by_right_click, true)
 	DECLARE_PROPERTY(float, dim_strength, 0.25)
 
+	// Layout updates per second while the window is being resized. 0 updates every frame.
+	DECLARE_PROPERTY(float, live_resize_rate, 30)
+	// Render scale of 3D content while the window is being resized. 1 keeps full quality.
+	DECLARE_PROPERTY(float, live_resize_render_scale, 1)
+
+	// Only the visible Controls with MOUSE_FILTER_STOP get the mouse, clicks
+	// anywhere else reach the windows below. Meant for overlays with the
+	// TRANSPARENT backdrop: on Windows the rest of the window isn't drawn.
+	DECLARE_PROPERTY(bool, mouse_passthrough, false)
+
+	// Render only when something changes: input, a style property, the layout,
+	// a running tween or request_frame(). The engine sleeps between iterations
+	// (low processor mode). Rendering is global, so only the AcrylicWindow of
+	// the main window can enable it.
+	DECLARE_PROPERTY(bool, on_demand_rendering, false)
+	// Iterations per second of on_demand_rendering while nothing changes.
+	// Input waits up to 1 / on_demand_idle_rate seconds to be processed.
+	DECLARE_PROPERTY(float, on_demand_idle_rate, 30)
+
+	// Linux windows keep the window manager decorations until frame is set.
 	DECLARE_PROPERTY(Frame, frame, FRAME_CUSTOM)
 	DECLARE_PROPERTY(Backdrop, backdrop, BACKDROP_ACRYLIC)
 	DECLARE_PROPERTY(Corner, corner, CORNER_DEFAULT)
@@ -86,12 +141,85 @@ public:
 	DECLARE_PROPERTY(Color&, text_color, Color(1, 1, 1))
 	DECLARE_PROPERTY(Color&, clear_color, Color(0, 0, 0))
 
+	// Shared style. Its values replace the properties above except the ones
+	// listed in theme_overrides. Named acrylic_theme because Control has theme.
+	DECLARE_PROPERTY(Ref<AcrylicTheme>&, acrylic_theme, Ref<AcrylicTheme>())
+	DECLARE_PROPERTY(int64_t, theme_overrides, 0)
+
+public:
+	~AcrylicWindow();
+
 public:
 	void minimize();
 	void maximize(bool toggle = true);
 	void close();
 	void dim(bool on);
 
+	// Changes between begin_style_update and end_style_update are previewed
+	// and applied once on end_style_update. Calls can be nested.
+	void begin_style_update();
+	void end_style_update();
+
+	// All the style properties in one call. set_style validates the whole
+	// dictionary, changes nothing if a key or value is invalid, and applies
+	// the given properties to the native window in one pass. Missing keys
+	// keep their values.
+	Dictionary get_style() const;
+	bool set_style(const Dictionary& style);
+
+	// Opaque and blur regions for compositors that read them from the window
+	// (_NET_WM_OPAQUE_REGION and _KDE_NET_WM_BLUR_BEHIND_REGION on X11) and
+	// the mouse_passthrough polygon. Controls in the "acrylic_opaque" group are
+	// treated as opaque. Regions are recomputed at the end of the frame when
+	// the window size, text_size, backdrop, base_color or the rect of a watched
+	// control changes, and are republished only if they differ. Call it after
+	// adding a control to the group or changing a mouse_filter. The hit-test
+	// snapshot of the native window is published along with them.
+	void queue_region_update();
+
+	// Published with the regions. Native hit tests read it on any thread
+	// instead of the scene tree. Not exposed to scripts. Changes that emit
+	// no watched signal, like a mouse_filter or a transform, are caught by
+	// a check of the mouse rects every frame and published within a frame.
+	const acrylic::HitTestBuffer& get_hit_test_buffer() const;
+
+	// Renders the next frame with on_demand_rendering, e.g. after a script
+	// changed what's on screen.
+	void request_frame();
+	// Frames rendered and skipped since on_demand_rendering was enabled.
+	int64_t get_rendered_frames() const;
+	int64_t get_skipped_frames() const;
+
+	// Starts an interactive resize by the system (e.g. from a custom resize handle).
+	void start_resize(DisplayServer::WindowResizeEdge edge);
+
+	// Live resize freezes the layout, relayouts at live_resize_rate and does
+	// a full pass on end_live_resize. It's detected automatically, these are for
+	// platforms and custom resize code that the detection doesn't cover.
+	// If until_ended is false, the resize ends after a pause in size changes.
+	void begin_live_resize(bool until_ended = false);
+	void end_live_resize();
+	bool is_live_resizing() const;
+
+public:
+	// Records trace spans of the extension hot paths.
+	// stop_trace writes Chrome trace JSON that can be opened in Perfetto.
+	static bool start_trace();
+	static bool stop_trace(const String& path);
+
+	// Records the native window messages with the window geometry they were
+	// handled with, to replay the session offline with message-replay (Windows only).
+	static bool start_message_recording(const String& path);
+	static bool stop_message_recording();
+
+	// Time from the extension init to the first frame drawn with the style applied.
+	// See Project Settings > Acrylic Window > Startup to style the window before that frame.
+	static Dictionary get_startup_timings();
+
+	// Returns the AcrylicWindow of the native window or null.
+	// Embedded windows share the native window of their embedder and aren't registered.
+	static AcrylicWindow* find_by_window_id(int32_t window_id);
+
 public:
 	virtual void _ready() override;
 
@@ -103,13 +231,104 @@ private:
 	void on_draw();
 	void on_ready();
 	void on_exit_tree();
+	void on_process();
+	void on_screen_changed();
+	bool update_screen_scale();
+	void on_window_size_changed();
+	void update_window_mode();
+	void on_window_focus_in();
+	void process_live_resize(uint64_t now);
 
 private:	
 	void adjust_colors();
 	void apply_style();
+	void apply_theme();
+
+	void preview_text_size();
+	// force reapplies the content scale even if text_size hasn't changed.
+	void commit_text_size(bool force = false);
+	void reset_text_size_preview();
+	float get_content_scale(float p_text_size) const;
+
+	void update_processing();
+
+	void update_regions();
+	void update_mouse_passthrough(const std::vector<acrylic::Rect>& mouse_region);
+	void publish_hit_test(const std::vector<acrylic::Rect>& mouse_region, bool has_popup);
+	void check_mouse_region();
+	void add_mouse_rects(Node* node, const acrylic::Rect& bounds, const Transform2D& to_pixels, std::vector<acrylic::Rect>* rects, bool* has_popup);
+	void watch_node(Node* node);
+	void watch_tree(bool watch);
+	void on_tree_node_changed(Node* node);
+
+	void start_on_demand_rendering();
+	void stop_on_demand_rendering();
+	void on_process_frame();
+	void set_render_loop_enabled(bool enabled);
+	void on_frame_post_draw();
+	void on_window_input(const Ref<InputEvent>& event);
+	void on_style_changed(const Variant& value);
 
 private:
-	ColorRect* dim_rect;
+	// DisplayServer::INVALID_WINDOW_ID if not registered.
+	int32_t registered_window_id = -1;
+
+	int style_updates = 0;
+
+	// text_size applied to the window. text_size itself may be a preview.
+	float committed_text_size = 0;
+	bool previewing_text_size = false;
+	uint64_t text_size_deadline = 0; // usec
+	Transform2D canvas_transform;
+
+	// Whether frame has been set by the scene or a script. Until then the X11
+	// backend leaves the decorations to the window manager and Godot.
+	bool frame_set = false;
+
+	// Screen and its scale used by auto_text_size. -1 if not known yet.
+	// The screen is looked up again after invalidate_screen_scales.
+	int current_screen = -1;
+	uint32_t current_screen_generation = 0;
+	float screen_scale = 1;
+
+	// Live resize. Anchors and offsets are restored when the resize ends.
+	bool live_resizing = false;
+	bool live_resize_until_ended = false;
+	bool live_resize_layout_pending = false;
+	uint64_t live_resize_last_change = 0; // usec
+	uint64_t live_resize_last_layout = 0; // usec
+	float live_resize_anchors[4] = {};
+	float live_resize_offsets[4] = {};
+	bool live_resize_reduced = false;
+	Viewport::MSAA live_resize_msaa_2d = Viewport::MSAA_DISABLED;
+	float live_resize_scaling_3d_scale = 1;
+
+	// Size changes that followed each other closely. A burst starts a live resize.
+	int size_changes = 0;
+	uint64_t last_size_change = 0; // usec
+	// Window::Mode seen by the last size change. -1 before ready.
+	int window_mode = -1;
+
+	bool region_update_queued = false;
+	// The last polygon given to the native window. Empty if passthrough is off.
+	std::vector<acrylic::Point> mouse_passthrough_polygon;
+	acrylic::HitTestBuffer hit_test_buffer;
+	// Whether the native window reads hit_test_buffer, so it's checked every frame.
+	bool checking_hit_test = false;
+
+	// on_demand_rendering.
+	bool on_demand_active = false;
+	bool previous_low_processor_mode = false;
+	int64_t previous_low_processor_sleep = 0; // usec
+	bool render_loop_enabled = true;
+	bool frame_requested = false;
+	bool counting_frames = false;
+	// Set by frame_post_draw, which may come from the render thread.
+	std::atomic<bool> frame_drawn{ false };
+	int64_t rendered_frames = 0;
+	int64_t skipped_frames = 0;
+
+	ColorRect* dim_rect = nullptr;
 	Ref<Tween> dim_tween;
 };
 
@@ -120,3 +339,5 @@ VARIANT_ENUM_CAST(::godot::AcrylicWindow::Backdrop)
 VARIANT_ENUM_CAST(::godot::AcrylicWindow::Corner)
 VARIANT_ENUM_CAST(::godot::AcrylicWindow::Autohide)
 VARIANT_ENUM_CAST(::godot::AcrylicWindow::Accent)
+VARIANT_ENUM_CAST(::godot::AcrylicWindow::Rescale)
+VARIANT_ENUM_CAST(::godot::AcrylicWindow::ThemeOverride)
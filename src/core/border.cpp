@@ -0,0 +1,92 @@
+/**************************************************************************/
+/*  border.cpp                                                            */
+/*  Godot independent window border and hit zone math.                    */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "border.hpp"
+
+namespace acrylic {
+
+Border get_window_border(const Rect& frame_rect, bool maximized) {
+	Border border;
+
+	// Divide top by 5 because Windows returns -10
+	// though -2 is enough to hide thick border at the top.
+	border.top = maximized ? frame_rect.top : (frame_rect.top / 5);
+	border.left = frame_rect.left;
+	border.right = frame_rect.right;
+	border.bottom = frame_rect.bottom;
+
+	return border;
+}
+
+BorderMetrics get_border_metrics(const Rect& frame_rect, const Rect& caption_rect, bool maximized) {
+	BorderMetrics metrics;
+	metrics.border = get_window_border(frame_rect, maximized);
+	metrics.caption_top = caption_rect.top;
+
+	return metrics;
+}
+
+bool BorderMetricsCache::is_valid() const {
+	return valid;
+}
+
+void BorderMetricsCache::invalidate() {
+	valid = false;
+}
+
+void BorderMetricsCache::store(const Rect& p_frame_rect, const Rect& p_caption_rect) {
+	frame_rect = p_frame_rect;
+	caption_rect = p_caption_rect;
+	valid = true;
+}
+
+BorderMetrics BorderMetricsCache::get(bool maximized) const {
+	return get_border_metrics(frame_rect, caption_rect, maximized);
+}
+
+const Rect& BorderMetricsCache::get_frame_rect() const {
+	return frame_rect;
+}
+
+const Rect& BorderMetricsCache::get_caption_rect() const {
+	return caption_rect;
+}
+
+bool calculate_client_rect(Frame frame, const Border& border, Rect* client_rect) {
+	if (frame == FRAME_DEFAULT)
+		return false;
+
+	if (frame == FRAME_BORDERLESS) {
+		// remove a thin resize border at the top
+		client_rect->top -= 2;
+		return true;
+	}
+
+	client_rect->top -= border.top;
+	client_rect->left -= border.left;
+	client_rect->right -= border.right;
+	client_rect->bottom -= border.bottom;
+
+	return true;
+}
+
+HitZone get_hit_zone(int32_t client_y, const Border& border, bool drag_by_content, int32_t caption_top) {
+	if (client_y < -border.top)
+		return HIT_ZONE_RESIZE_TOP;
+
+	if (drag_by_content || client_y < -caption_top)
+		return HIT_ZONE_DRAG;
+
+	return HIT_ZONE_CLIENT;
+}
+
+}
@@ -0,0 +1,74 @@
+/**************************************************************************/
+/*  border.hpp                                                            */
+/*  Godot independent window border and hit zone math.                    */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "geometry.hpp"
+#include "style.hpp"
+
+namespace acrylic {
+
+// Used when the native border can't be queried.
+constexpr Border DEFAULT_CALCSIZE_BORDER = { 5, 5, 5, 5 };
+constexpr Border DEFAULT_HITTEST_BORDER = { -10, 5, 5, 5 };
+
+// frame_rect is the rect that AdjustWindowRectEx returns for an empty
+// client rect and the window style without WS_CAPTION.
+Border get_window_border(const Rect& frame_rect, bool maximized);
+
+struct BorderMetrics {
+	Border border;
+	// Top of the frame with a caption. Only used if drag_by_content is false.
+	int32_t caption_top = 0;
+};
+
+// caption_rect is the rect that AdjustWindowRectEx returns for an empty
+// client rect and the window style with WS_CAPTION.
+BorderMetrics get_border_metrics(const Rect& frame_rect, const Rect& caption_rect, bool maximized);
+
+// The frame rects depend only on the window style and DPI, so they are
+// queried once and kept until either changes. The maximized state is
+// cheap to query and is applied on every get.
+class BorderMetricsCache {
+public:
+	bool is_valid() const;
+	void invalidate();
+
+	void store(const Rect& frame_rect, const Rect& caption_rect);
+
+	// Must be valid.
+	BorderMetrics get(bool maximized) const;
+	const Rect& get_frame_rect() const;
+	const Rect& get_caption_rect() const;
+
+private:
+	bool valid = false;
+	Rect frame_rect;
+	Rect caption_rect;
+};
+
+// Adjusts the proposed client rect of WM_NCCALCSIZE.
+// Returns false if the default frame must be used.
+bool calculate_client_rect(Frame frame, const Border& border, Rect* client_rect);
+
+enum HitZone {
+	HIT_ZONE_CLIENT,
+	HIT_ZONE_RESIZE_TOP,
+	// The window can be dragged here unless a control blocks the mouse.
+	HIT_ZONE_DRAG
+};
+
+// caption_top is the top of AdjustWindowRectEx with WS_CAPTION.
+// It's only used if drag_by_content is false.
+HitZone get_hit_zone(int32_t client_y, const Border& border, bool drag_by_content, int32_t caption_top);
+
+}
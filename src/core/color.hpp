@@ -0,0 +1,58 @@
+/**************************************************************************/
+/*  color.hpp                                                             */
+/*  Godot independent color math used by AcrylicWindow.                   */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+namespace acrylic {
+
+// Mirrors the math of godot::Color so the results are identical.
+struct Rgba {
+	float r = 0;
+	float g = 0;
+	float b = 0;
+	float a = 1;
+
+	constexpr Rgba() = default;
+	constexpr Rgba(float r, float g, float b, float a = 1)
+		: r(r), g(g), b(b), a(a)
+	{}
+
+	constexpr float get_luminance() const {
+		return 0.2126f * r + 0.7152f * g + 0.0722f * b;
+	}
+
+	constexpr Rgba lerp(const Rgba& to, float weight) const {
+		return Rgba(
+			r + weight * (to.r - r),
+			g + weight * (to.g - g),
+			b + weight * (to.b - b),
+			a + weight * (to.a - a));
+	}
+
+	constexpr Rgba darkened(float amount) const {
+		return Rgba(r * (1 - amount), g * (1 - amount), b * (1 - amount), a);
+	}
+
+	constexpr Rgba operator*(float scale) const {
+		return Rgba(r * scale, g * scale, b * scale, a * scale);
+	}
+
+	constexpr bool operator==(const Rgba& other) const {
+		return r == other.r && g == other.g && b == other.b && a == other.a;
+	}
+
+	constexpr bool operator!=(const Rgba& other) const {
+		return !(*this == other);
+	}
+};
+
+}
@@ -0,0 +1,51 @@
+/**************************************************************************/
+/*  geometry.hpp                                                          */
+/*  Godot independent geometry types.                                     */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace acrylic {
+
+struct Point {
+	int32_t x = 0;
+	int32_t y = 0;
+
+	constexpr bool operator==(const Point& other) const {
+		return x == other.x && y == other.y;
+	}
+
+	constexpr bool operator!=(const Point& other) const {
+		return !(*this == other);
+	}
+};
+
+// Same layout as RECT on Windows.
+struct Rect {
+	int32_t left = 0;
+	int32_t top = 0;
+	int32_t right = 0;
+	int32_t bottom = 0;
+
+	constexpr bool operator==(const Rect& other) const {
+		return left == other.left && top == other.top && right == other.right && bottom == other.bottom;
+	}
+
+	constexpr bool operator!=(const Rect& other) const {
+		return !(*this == other);
+	}
+};
+
+// Offsets of the window edges from the client area edges.
+typedef Rect Border;
+
+}
@@ -0,0 +1,45 @@
+/**************************************************************************/
+/*  hit_test.cpp                                                          */
+/*  Godot independent hit tests against a published snapshot.             */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "hit_test.hpp"
+
+#include "region.hpp"
+
+#include <thread>
+
+namespace acrylic {
+
+bool is_draggable(const HitTestSnapshot& snapshot, const Point& client_point) {
+	if (snapshot.generation == 0 || snapshot.has_popup)
+		return false;
+
+	return !contains(snapshot.blocking_region, client_point);
+}
+
+HitTestSnapshot& HitTestBuffer::begin_write() {
+	uint32_t back = 1 - front.load(std::memory_order_relaxed);
+
+	// Pairs with the check of front in read: a reader either sees the new
+	// front and leaves, or it's counted here.
+	while (readers[back].load() != 0)
+		std::this_thread::yield();
+
+	return snapshots[back];
+}
+
+void HitTestBuffer::publish() {
+	uint32_t back = 1 - front.load(std::memory_order_relaxed);
+	snapshots[back].generation = ++generation;
+	front.store(back);
+}
+
+}
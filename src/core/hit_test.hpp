@@ -0,0 +1,75 @@
+/**************************************************************************/
+/*  hit_test.hpp                                                          */
+/*  Godot independent hit tests against a published snapshot.             */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "geometry.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace acrylic {
+
+// What a hit test needs to know about a window. AcrylicWindow captures it
+// when the layout changes, so hit tests never touch the scene tree.
+struct HitTestSnapshot {
+	// 0 until the first publish.
+	uint64_t generation = 0;
+	// Client pixels of the visible controls that stop the mouse,
+	// as returned by merge_rects.
+	std::vector<Rect> blocking_region;
+	bool has_popup = false;
+	bool drag_by_content = false;
+	bool drag_by_right_click = false;
+};
+
+// Whether a point of the drag zone drags the window. Nothing is dragged
+// while a popup is open so that the click can close it.
+bool is_draggable(const HitTestSnapshot& snapshot, const Point& client_point);
+
+// Two snapshots: one writer fills the back one and publishes it with an
+// atomic store, readers on any thread read the front one without locks.
+// A reader that races a publish retries, and the writer doesn't reuse a
+// buffer until its readers are done, so readers always see a whole snapshot.
+class HitTestBuffer {
+public:
+	// The back snapshot. Waits for the readers that took it before the last publish.
+	HitTestSnapshot& begin_write();
+	void publish();
+
+	// Calls f with the front snapshot. f must not keep references to it.
+	template <typename F>
+	void read(F&& f) const {
+		while (true) {
+			uint32_t index = front.load();
+			readers[index].fetch_add(1);
+
+			if (front.load() == index) {
+				f(static_cast<const HitTestSnapshot&>(snapshots[index]));
+				readers[index].fetch_sub(1, std::memory_order_release);
+				return;
+			}
+
+			readers[index].fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+private:
+	HitTestSnapshot snapshots[2];
+	std::atomic<uint32_t> front{ 0 };
+	mutable std::atomic<uint32_t> readers[2] = {};
+	// Touched only by the writer.
+	uint64_t generation = 0;
+};
+
+}
@@ -0,0 +1,45 @@
+/**************************************************************************/
+/*  item_texts.cpp                                                        */
+/*  Item texts packed into one buffer.                                    */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "item_texts.hpp"
+
+namespace acrylic {
+
+void ItemTexts::clear() {
+	data.clear();
+	ends.clear();
+}
+
+void ItemTexts::reserve(size_t count, size_t bytes) {
+	ends.reserve(count);
+	data.reserve(bytes);
+}
+
+void ItemTexts::add(std::string_view text) {
+	data.append(text.data(), text.size());
+	ends.push_back(static_cast<uint32_t>(data.size()));
+}
+
+size_t ItemTexts::size() const {
+	return ends.size();
+}
+
+std::string_view ItemTexts::get(size_t index) const {
+	uint32_t start = index ? ends[index - 1] : 0;
+	return std::string_view(data.data() + start, ends[index] - start);
+}
+
+size_t ItemTexts::get_memory_usage() const {
+	return data.capacity() + ends.capacity() * sizeof(uint32_t);
+}
+
+}
@@ -0,0 +1,42 @@
+/**************************************************************************/
+/*  item_texts.hpp                                                        */
+/*  Item texts packed into one buffer.                                    */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace acrylic {
+
+// UTF-8 texts of list items stored back to back in one buffer.
+// Costs 4 bytes per item on top of the text instead of an allocation per item.
+class ItemTexts {
+public:
+	void clear();
+	void reserve(size_t count, size_t bytes);
+	void add(std::string_view text);
+
+	size_t size() const;
+	std::string_view get(size_t index) const;
+
+	size_t get_memory_usage() const;
+
+private:
+	std::string data;
+	// End of each item in data. The item starts where the previous one ends.
+	std::vector<uint32_t> ends;
+};
+
+}
@@ -0,0 +1,193 @@
+/**************************************************************************/
+/*  message.cpp                                                           */
+/*  Godot independent handlers of the native window messages.             */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "message.hpp"
+
+#include "border.hpp"
+
+#include <climits>
+
+namespace acrylic {
+
+namespace {
+	// GET_X_LPARAM and GET_Y_LPARAM.
+	Point get_lparam_point(int64_t lparam) {
+		return {
+			static_cast<int16_t>(lparam & 0xffff),
+			static_cast<int16_t>((lparam >> 16) & 0xffff)
+		};
+	}
+
+	MessageResult handled(int64_t value) {
+		MessageResult result;
+		result.handled = true;
+		result.result = value;
+		return result;
+	}
+
+	MessageResult on_nchittest(MessageState& state, const HitTestSnapshot& snapshot, const MessageGeometry& geometry, const Message& message) {
+		if (geometry.default_hit_test != HIT_TEST_CLIENT)
+			return handled(geometry.default_hit_test);
+
+		BorderMetrics metrics;
+		if (geometry.has_frame_rects) {
+			metrics = get_border_metrics(geometry.frame_rect, geometry.caption_rect, geometry.maximized);
+		}
+		else {
+			metrics.border = DEFAULT_HITTEST_BORDER;
+			// Nothing is draggable.
+			metrics.caption_top = INT_MAX;
+		}
+
+		Point screen_cursor = get_lparam_point(message.lparam);
+		Point client_cursor = {
+			screen_cursor.x - geometry.client_origin.x,
+			screen_cursor.y - geometry.client_origin.y
+		};
+
+		HitZone zone = get_hit_zone(client_cursor.y, metrics.border, snapshot.drag_by_content, metrics.caption_top);
+		if (zone == HIT_ZONE_RESIZE_TOP)
+			return handled(HIT_TEST_TOP);
+
+		if (state.right_click_drag.is_pressed() && snapshot.drag_by_right_click) {
+			if (!geometry.right_button_down) {
+				state.right_click_drag.release();
+			}
+			else {
+				Point delta;
+				if (state.right_click_drag.move(screen_cursor, &delta) && geometry.has_window_rect) {
+					MessageResult result = handled(HIT_TEST_CAPTION);
+					result.actions = MESSAGE_ACTION_MOVE;
+					result.window_position = { geometry.window_rect.left + delta.x, geometry.window_rect.top + delta.y };
+					return result;
+				}
+			}
+		}
+
+		// Open popups and controls that stop the mouse keep the click.
+		if (zone == HIT_ZONE_DRAG && is_draggable(snapshot, client_cursor))
+			return handled(HIT_TEST_CAPTION);
+
+		return MessageResult();
+	}
+
+	MessageResult on_nccalcsize(Frame frame, const MessageGeometry& geometry, const Message& message) {
+		if (!message.wparam)
+			return MessageResult();
+
+		BorderMetrics metrics;
+		if (frame == FRAME_CUSTOM) {
+			if (geometry.has_frame_rects)
+				metrics = get_border_metrics(geometry.frame_rect, geometry.caption_rect, geometry.maximized);
+			else
+				metrics.border = DEFAULT_CALCSIZE_BORDER;
+		}
+
+		Rect client_rect = geometry.proposed_client_rect;
+		if (!calculate_client_rect(frame, metrics.border, &client_rect))
+			return MessageResult();
+
+		MessageResult result = handled(0);
+		result.actions = MESSAGE_ACTION_SET_CLIENT_RECT;
+		result.client_rect = client_rect;
+		return result;
+	}
+
+	MessageResult on_ncactivate(const Message& message) {
+		MessageResult result = handled(0);
+		result.actions = message.wparam ? MESSAGE_ACTION_UNDIM : MESSAGE_ACTION_DIM;
+		return result;
+	}
+
+	MessageResult on_key_up(const Message& message) {
+		// Use magical numbers because Godot overrides key constants on Windows.
+		if (message.wparam != 0x7A) // F11
+			return MessageResult();
+
+		MessageResult result = handled(0);
+		result.actions = MESSAGE_ACTION_MAXIMIZE;
+		return result;
+	}
+
+	MessageResult on_syskey_up(const Message& message) {
+		if (message.wparam != 0x0D) // ENTER
+			return MessageResult();
+
+		if (!(message.lparam & (1 << 24)) && !(message.lparam & (1 << 29))) // ALT
+			return MessageResult();
+
+		MessageResult result = handled(0);
+		result.actions = MESSAGE_ACTION_MAXIMIZE;
+		return result;
+	}
+}
+
+const char* get_message_name(uint32_t id) {
+	switch (id) {
+	case MESSAGE_NCCALCSIZE: return "WM_NCCALCSIZE";
+	case MESSAGE_NCHITTEST: return "WM_NCHITTEST";
+	case MESSAGE_NCACTIVATE: return "WM_NCACTIVATE";
+	case MESSAGE_NCRBUTTONDOWN: return "WM_NCRBUTTONDOWN";
+	case MESSAGE_NCRBUTTONUP: return "WM_NCRBUTTONUP";
+	case MESSAGE_KEYUP: return "WM_KEYUP";
+	case MESSAGE_SYSKEYUP: return "WM_SYSKEYUP";
+	case MESSAGE_RBUTTONDOWN: return "WM_RBUTTONDOWN";
+	case MESSAGE_RBUTTONUP: return "WM_RBUTTONUP";
+	default: return nullptr;
+	}
+}
+
+bool MessageResult::operator==(const MessageResult& other) const {
+	return handled == other.handled && result == other.result && actions == other.actions
+		&& window_position == other.window_position && client_rect == other.client_rect;
+}
+
+bool MessageResult::operator!=(const MessageResult& other) const {
+	return !(*this == other);
+}
+
+MessageResult handle_message(MessageState& state, Frame frame, const HitTestSnapshot& snapshot, const MessageGeometry& geometry, const Message& message) {
+	switch (message.id) {
+	case MESSAGE_NCHITTEST:
+		return on_nchittest(state, snapshot, geometry, message);
+
+	case MESSAGE_NCCALCSIZE:
+		return on_nccalcsize(frame, geometry, message);
+
+	case MESSAGE_NCACTIVATE:
+		return on_ncactivate(message);
+
+	case MESSAGE_KEYUP:
+		return on_key_up(message);
+
+	case MESSAGE_SYSKEYUP:
+		return on_syskey_up(message);
+
+	case MESSAGE_RBUTTONDOWN: {
+		Point client_position = get_lparam_point(message.lparam);
+		state.right_click_drag.press({ client_position.x + geometry.client_origin.x, client_position.y + geometry.client_origin.y });
+	} break;
+
+	case MESSAGE_NCRBUTTONDOWN:
+		state.right_click_drag.press(get_lparam_point(message.lparam));
+		break;
+
+	case MESSAGE_RBUTTONUP:
+	case MESSAGE_NCRBUTTONUP:
+		state.right_click_drag.release();
+		break;
+	}
+
+	return MessageResult();
+}
+
+}
@@ -0,0 +1,105 @@
+/**************************************************************************/
+/*  message.hpp                                                           */
+/*  Godot independent handlers of the native window messages.             */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "geometry.hpp"
+#include "hit_test.hpp"
+#include "right_click_drag.hpp"
+#include "style.hpp"
+
+#include <cstdint>
+
+namespace acrylic {
+
+// The values of WM_*, so recordings keep the native message ids.
+enum MessageId : uint32_t {
+	MESSAGE_NCCALCSIZE = 0x0083,
+	MESSAGE_NCHITTEST = 0x0084,
+	MESSAGE_NCACTIVATE = 0x0086,
+	MESSAGE_NCRBUTTONDOWN = 0x00A4,
+	MESSAGE_NCRBUTTONUP = 0x00A5,
+	MESSAGE_KEYUP = 0x0101,
+	MESSAGE_SYSKEYUP = 0x0105,
+	MESSAGE_RBUTTONDOWN = 0x0204,
+	MESSAGE_RBUTTONUP = 0x0205
+};
+
+// The values of HT* returned by WM_NCHITTEST.
+constexpr int32_t HIT_TEST_CLIENT = 1;
+constexpr int32_t HIT_TEST_CAPTION = 2;
+constexpr int32_t HIT_TEST_TOP = 12;
+
+// Returns null for the messages that handle_message doesn't know.
+const char* get_message_name(uint32_t id);
+
+struct Message {
+	uint32_t id = 0;
+	uint64_t wparam = 0;
+	int64_t lparam = 0;
+	// Nanoseconds since the recording started. Set by MessageRecorder.
+	int64_t time = 0;
+};
+
+// The native state that the handlers read. The native side queries only
+// what the message needs, the rest stays zero.
+struct MessageGeometry {
+	// WM_NCHITTEST, WM_RBUTTONDOWN: screen position of the client area.
+	Point client_origin;
+	// WM_NCHITTEST, WM_NCCALCSIZE: see get_border_metrics.
+	bool has_frame_rects = false;
+	Rect frame_rect;
+	Rect caption_rect;
+	bool maximized = false;
+	// WM_NCHITTEST: the result of the default window procedure.
+	int32_t default_hit_test = HIT_TEST_CLIENT;
+	// WM_NCHITTEST while a right click drag is pressed.
+	bool right_button_down = false;
+	bool has_window_rect = false;
+	Rect window_rect;
+	// WM_NCCALCSIZE: the proposed client rect.
+	Rect proposed_client_rect;
+};
+
+enum MessageAction : uint32_t {
+	MESSAGE_ACTION_MAXIMIZE = 1u << 0,
+	MESSAGE_ACTION_DIM = 1u << 1,
+	MESSAGE_ACTION_UNDIM = 1u << 2,
+	// Move the window to window_position.
+	MESSAGE_ACTION_MOVE = 1u << 3,
+	// Replace the proposed client rect with client_rect.
+	MESSAGE_ACTION_SET_CLIENT_RECT = 1u << 4
+};
+
+// What the native side must do. If handled is false the message goes on
+// to the next window procedure, otherwise result is returned.
+struct MessageResult {
+	bool handled = false;
+	int64_t result = 0;
+	uint32_t actions = 0;
+	Point window_position;
+	Rect client_rect;
+
+	bool operator==(const MessageResult& other) const;
+	bool operator!=(const MessageResult& other) const;
+};
+
+// What the handlers keep between the messages of a window.
+struct MessageState {
+	RightClickDrag right_click_drag;
+};
+
+// Handles the messages that AcrylicWindow overrides without touching the
+// native window, so recorded sessions can be replayed on any platform.
+MessageResult handle_message(MessageState& state, Frame frame, const HitTestSnapshot& snapshot, const MessageGeometry& geometry, const Message& message);
+
+}
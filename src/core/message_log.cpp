@@ -0,0 +1,418 @@
+/**************************************************************************/
+/*  message_log.cpp                                                       */
+/*  Binary recordings of the native window messages.                      */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "message_log.hpp"
+
+#include <chrono>
+
+namespace acrylic {
+
+namespace {
+	// Flush at this size to keep the memory of long recordings bounded.
+	constexpr size_t FLUSH_THRESHOLD = 1 << 16;
+
+	int64_t now() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	class Writer {
+	public:
+		explicit Writer(std::vector<uint8_t>& buffer)
+			: buffer(buffer)
+		{}
+
+		void u8(uint8_t value) {
+			buffer.push_back(value);
+		}
+
+		void u32(uint32_t value) {
+			for (int shift = 0; shift < 32; shift += 8)
+				buffer.push_back(static_cast<uint8_t>(value >> shift));
+		}
+
+		void u64(uint64_t value) {
+			for (int shift = 0; shift < 64; shift += 8)
+				buffer.push_back(static_cast<uint8_t>(value >> shift));
+		}
+
+		void i32(int32_t value) {
+			u32(static_cast<uint32_t>(value));
+		}
+
+		void i64(int64_t value) {
+			u64(static_cast<uint64_t>(value));
+		}
+
+		void point(const Point& value) {
+			i32(value.x);
+			i32(value.y);
+		}
+
+		void rect(const Rect& value) {
+			i32(value.left);
+			i32(value.top);
+			i32(value.right);
+			i32(value.bottom);
+		}
+
+	private:
+		std::vector<uint8_t>& buffer;
+	};
+
+	// Reads past the end return zeros and make the reader fail.
+	class Reader {
+	public:
+		Reader(const std::vector<uint8_t>& data, size_t& offset)
+			: data(data)
+			, offset(offset)
+		{}
+
+		bool is_ok() const {
+			return ok;
+		}
+
+		uint8_t u8() {
+			if (offset + 1 > data.size()) {
+				ok = false;
+				return 0;
+			}
+
+			return data[offset++];
+		}
+
+		uint32_t u32() {
+			if (offset + 4 > data.size()) {
+				ok = false;
+				return 0;
+			}
+
+			uint32_t value = 0;
+			for (int i = 0; i < 4; i++)
+				value |= static_cast<uint32_t>(data[offset++]) << (i * 8);
+
+			return value;
+		}
+
+		uint64_t u64() {
+			if (offset + 8 > data.size()) {
+				ok = false;
+				return 0;
+			}
+
+			uint64_t value = 0;
+			for (int i = 0; i < 8; i++)
+				value |= static_cast<uint64_t>(data[offset++]) << (i * 8);
+
+			return value;
+		}
+
+		int32_t i32() {
+			return static_cast<int32_t>(u32());
+		}
+
+		int64_t i64() {
+			return static_cast<int64_t>(u64());
+		}
+
+		Point point() {
+			Point value;
+			value.x = i32();
+			value.y = i32();
+			return value;
+		}
+
+		Rect rect() {
+			Rect value;
+			value.left = i32();
+			value.top = i32();
+			value.right = i32();
+			value.bottom = i32();
+			return value;
+		}
+
+	private:
+		const std::vector<uint8_t>& data;
+		size_t& offset;
+		bool ok = true;
+	};
+
+	enum GeometryFlag : uint8_t {
+		GEOMETRY_HAS_FRAME_RECTS = 1u << 0,
+		GEOMETRY_MAXIMIZED = 1u << 1,
+		GEOMETRY_RIGHT_BUTTON_DOWN = 1u << 2,
+		GEOMETRY_HAS_WINDOW_RECT = 1u << 3
+	};
+
+	enum SnapshotFlag : uint8_t {
+		SNAPSHOT_HAS_POPUP = 1u << 0,
+		SNAPSHOT_DRAG_BY_CONTENT = 1u << 1,
+		SNAPSHOT_DRAG_BY_RIGHT_CLICK = 1u << 2
+	};
+}
+
+MessageRecorder::~MessageRecorder() {
+	stop();
+}
+
+bool MessageRecorder::start(const char* path) {
+	if (file)
+		return false;
+
+	file = fopen(path, "wb");
+	if (!file)
+		return false;
+
+	failed = false;
+	origin = now();
+	buffer.clear();
+	windows.clear();
+
+	Writer writer(buffer);
+	writer.u32(MESSAGE_LOG_MAGIC);
+	writer.u32(MESSAGE_LOG_VERSION);
+
+	return true;
+}
+
+bool MessageRecorder::stop() {
+	if (!file)
+		return false;
+
+	flush();
+
+	if (fclose(file) != 0)
+		failed = true;
+
+	file = nullptr;
+	windows.clear();
+
+	return !failed;
+}
+
+bool MessageRecorder::is_recording() const {
+	return file != nullptr;
+}
+
+void MessageRecorder::record(uint64_t window_key, Frame frame, const HitTestSnapshot& snapshot,
+		const MessageGeometry& geometry, const Message& message, const MessageResult& result) {
+	if (!file)
+		return;
+
+	uint32_t window = get_window_index(window_key, frame, snapshot);
+
+	uint8_t flags = 0;
+	if (geometry.has_frame_rects)
+		flags |= GEOMETRY_HAS_FRAME_RECTS;
+	if (geometry.maximized)
+		flags |= GEOMETRY_MAXIMIZED;
+	if (geometry.right_button_down)
+		flags |= GEOMETRY_RIGHT_BUTTON_DOWN;
+	if (geometry.has_window_rect)
+		flags |= GEOMETRY_HAS_WINDOW_RECT;
+
+	Writer writer(buffer);
+	writer.u8(MESSAGE_LOG_MESSAGE);
+	writer.u32(window);
+
+	writer.u32(message.id);
+	writer.u64(message.wparam);
+	writer.i64(message.lparam);
+	writer.i64(now() - origin);
+
+	writer.u8(flags);
+	writer.point(geometry.client_origin);
+	writer.rect(geometry.frame_rect);
+	writer.rect(geometry.caption_rect);
+	writer.i32(geometry.default_hit_test);
+	writer.rect(geometry.window_rect);
+	writer.rect(geometry.proposed_client_rect);
+
+	writer.u8(result.handled ? 1 : 0);
+	writer.i64(result.result);
+	writer.u32(result.actions);
+	writer.point(result.window_position);
+	writer.rect(result.client_rect);
+
+	if (buffer.size() >= FLUSH_THRESHOLD)
+		flush();
+}
+
+uint32_t MessageRecorder::get_window_index(uint64_t window_key, Frame frame, const HitTestSnapshot& snapshot) {
+	uint32_t index = 0;
+	while (index < windows.size() && windows[index].key != window_key)
+		index++;
+
+	bool added = index == windows.size();
+	if (added) {
+		Window window;
+		window.key = window_key;
+		windows.push_back(window);
+	}
+
+	Window& window = windows[index];
+	Writer writer(buffer);
+
+	if (added || window.frame != frame) {
+		window.frame = frame;
+
+		writer.u8(MESSAGE_LOG_FRAME);
+		writer.u32(index);
+		writer.u8(static_cast<uint8_t>(frame));
+	}
+
+	if (added || window.generation != snapshot.generation) {
+		window.generation = snapshot.generation;
+
+		uint8_t flags = 0;
+		if (snapshot.has_popup)
+			flags |= SNAPSHOT_HAS_POPUP;
+		if (snapshot.drag_by_content)
+			flags |= SNAPSHOT_DRAG_BY_CONTENT;
+		if (snapshot.drag_by_right_click)
+			flags |= SNAPSHOT_DRAG_BY_RIGHT_CLICK;
+
+		writer.u8(MESSAGE_LOG_SNAPSHOT);
+		writer.u32(index);
+		writer.u64(snapshot.generation);
+		writer.u8(flags);
+		writer.u32(static_cast<uint32_t>(snapshot.blocking_region.size()));
+		for (const Rect& rect : snapshot.blocking_region)
+			writer.rect(rect);
+	}
+
+	return index;
+}
+
+void MessageRecorder::flush() {
+	if (buffer.empty())
+		return;
+
+	if (fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+		failed = true;
+
+	buffer.clear();
+}
+
+bool MessageLogReader::open(const char* path) {
+	data.clear();
+	offset = 0;
+	corrupted = false;
+
+	FILE* file = fopen(path, "rb");
+	if (!file)
+		return false;
+
+	uint8_t chunk[1 << 16];
+	size_t count = 0;
+	while ((count = fread(chunk, 1, sizeof(chunk), file)) > 0)
+		data.insert(data.end(), chunk, chunk + count);
+
+	bool read_failed = ferror(file) != 0;
+	fclose(file);
+
+	if (read_failed)
+		return false;
+
+	Reader reader(data, offset);
+	uint32_t magic = reader.u32();
+	uint32_t version = reader.u32();
+
+	return reader.is_ok() && magic == MESSAGE_LOG_MAGIC && version == MESSAGE_LOG_VERSION;
+}
+
+bool MessageLogReader::read(MessageLogRecord* record) {
+	if (corrupted || offset >= data.size())
+		return false;
+
+	Reader reader(data, offset);
+
+	uint8_t type = reader.u8();
+	record->window = reader.u32();
+
+	switch (type) {
+	case MESSAGE_LOG_FRAME:
+		record->type = MESSAGE_LOG_FRAME;
+		record->frame = static_cast<Frame>(reader.u8());
+		break;
+
+	case MESSAGE_LOG_SNAPSHOT: {
+		record->type = MESSAGE_LOG_SNAPSHOT;
+
+		HitTestSnapshot& snapshot = record->snapshot;
+		snapshot.generation = reader.u64();
+
+		uint8_t flags = reader.u8();
+		snapshot.has_popup = (flags & SNAPSHOT_HAS_POPUP) != 0;
+		snapshot.drag_by_content = (flags & SNAPSHOT_DRAG_BY_CONTENT) != 0;
+		snapshot.drag_by_right_click = (flags & SNAPSHOT_DRAG_BY_RIGHT_CLICK) != 0;
+
+		uint32_t count = reader.u32();
+		// A rect takes 16 bytes, more than that is a broken count.
+		if (count > (data.size() - offset) / 16) {
+			corrupted = true;
+			return false;
+		}
+
+		snapshot.blocking_region.resize(count);
+		for (Rect& rect : snapshot.blocking_region)
+			rect = reader.rect();
+	} break;
+
+	case MESSAGE_LOG_MESSAGE: {
+		record->type = MESSAGE_LOG_MESSAGE;
+
+		Message& message = record->message;
+		message.id = reader.u32();
+		message.wparam = reader.u64();
+		message.lparam = reader.i64();
+		message.time = reader.i64();
+
+		MessageGeometry& geometry = record->geometry;
+		uint8_t flags = reader.u8();
+		geometry.has_frame_rects = (flags & GEOMETRY_HAS_FRAME_RECTS) != 0;
+		geometry.maximized = (flags & GEOMETRY_MAXIMIZED) != 0;
+		geometry.right_button_down = (flags & GEOMETRY_RIGHT_BUTTON_DOWN) != 0;
+		geometry.has_window_rect = (flags & GEOMETRY_HAS_WINDOW_RECT) != 0;
+		geometry.client_origin = reader.point();
+		geometry.frame_rect = reader.rect();
+		geometry.caption_rect = reader.rect();
+		geometry.default_hit_test = reader.i32();
+		geometry.window_rect = reader.rect();
+		geometry.proposed_client_rect = reader.rect();
+
+		MessageResult& result = record->result;
+		result.handled = reader.u8() != 0;
+		result.result = reader.i64();
+		result.actions = reader.u32();
+		result.window_position = reader.point();
+		result.client_rect = reader.rect();
+	} break;
+
+	default:
+		corrupted = true;
+		return false;
+	}
+
+	if (!reader.is_ok()) {
+		corrupted = true;
+		return false;
+	}
+
+	return true;
+}
+
+bool MessageLogReader::is_corrupted() const {
+	return corrupted;
+}
+
+}
@@ -0,0 +1,101 @@
+/**************************************************************************/
+/*  message_log.hpp                                                       */
+/*  Binary recordings of the native window messages.                      */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "hit_test.hpp"
+#include "message.hpp"
+#include "style.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace acrylic {
+
+// The file starts with MESSAGE_LOG_MAGIC and MESSAGE_LOG_VERSION followed
+// by records. A record starts with its type and the index of its window.
+// Frames and snapshots are written only when they change, so a message
+// record has a fixed size. Integers are little-endian.
+constexpr uint32_t MESSAGE_LOG_MAGIC = 0x4C4D5741; // "AWML"
+constexpr uint32_t MESSAGE_LOG_VERSION = 1;
+
+enum MessageLogRecordType : uint8_t {
+	MESSAGE_LOG_FRAME = 1,
+	MESSAGE_LOG_SNAPSHOT = 2,
+	MESSAGE_LOG_MESSAGE = 3
+};
+
+struct MessageLogRecord {
+	MessageLogRecordType type = MESSAGE_LOG_MESSAGE;
+	uint32_t window = 0;
+	// MESSAGE_LOG_FRAME
+	Frame frame = FRAME_DEFAULT;
+	// MESSAGE_LOG_SNAPSHOT
+	HitTestSnapshot snapshot;
+	// MESSAGE_LOG_MESSAGE
+	Message message;
+	MessageGeometry geometry;
+	// What handle_message returned while recording.
+	MessageResult result;
+};
+
+// Records are buffered in memory and written when the buffer is full
+// or when the recording stops. Not thread safe.
+class MessageRecorder {
+public:
+	~MessageRecorder();
+
+	bool start(const char* path);
+	// Returns false if anything failed to be written.
+	bool stop();
+	bool is_recording() const;
+
+	// window_key tells the windows apart, e.g. the native handle.
+	void record(uint64_t window_key, Frame frame, const HitTestSnapshot& snapshot,
+		const MessageGeometry& geometry, const Message& message, const MessageResult& result);
+
+private:
+	struct Window {
+		uint64_t key = 0;
+		Frame frame = FRAME_DEFAULT;
+		uint64_t generation = 0;
+	};
+
+	uint32_t get_window_index(uint64_t window_key, Frame frame, const HitTestSnapshot& snapshot);
+	void flush();
+
+private:
+	FILE* file = nullptr;
+	bool failed = false;
+	int64_t origin = 0;
+	std::vector<uint8_t> buffer;
+	std::vector<Window> windows;
+};
+
+class MessageLogReader {
+public:
+	// Reads the whole log into memory.
+	bool open(const char* path);
+
+	// Returns false at the end of the log. A truncated or unknown record
+	// also ends the log and makes is_corrupted return true.
+	bool read(MessageLogRecord* record);
+	bool is_corrupted() const;
+
+private:
+	std::vector<uint8_t> data;
+	size_t offset = 0;
+	bool corrupted = false;
+};
+
+}
@@ -0,0 +1,359 @@
+/**************************************************************************/
+/*  region.cpp                                                            */
+/*  Godot independent regions made of rects.                              */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "region.hpp"
+
+#include <algorithm>
+
+namespace {
+	using acrylic::Point;
+	using acrylic::Rect;
+
+	struct Span {
+		int32_t left;
+		int32_t right;
+	};
+
+	// Merged spans of the rects that cover the whole band [top, bottom).
+	void get_band_spans(const std::vector<Rect>& rects, int32_t top, int32_t bottom, std::vector<Span>* spans) {
+		spans->clear();
+		for (const Rect& rect : rects) {
+			if (rect.top <= top && rect.bottom >= bottom && rect.left < rect.right)
+				spans->push_back({ rect.left, rect.right });
+		}
+
+		std::sort(spans->begin(), spans->end(), [](const Span& a, const Span& b) {
+			return a.left < b.left;
+		});
+
+		size_t count = 0;
+		for (const Span& span : *spans) {
+			if (count && span.left <= (*spans)[count - 1].right)
+				(*spans)[count - 1].right = std::max((*spans)[count - 1].right, span.right);
+			else
+				(*spans)[count++] = span;
+		}
+
+		spans->resize(count);
+	}
+
+	// Spans of [left, right) that aren't covered by the spans.
+	void invert_spans(int32_t left, int32_t right, const std::vector<Span>& spans, std::vector<Span>* inverted) {
+		inverted->clear();
+		for (const Span& span : spans) {
+			if (span.left > left)
+				inverted->push_back({ left, std::min(span.left, right) });
+
+			left = std::max(left, span.right);
+			if (left >= right)
+				return;
+		}
+
+		inverted->push_back({ left, right });
+	}
+
+	class BandWriter {
+	public:
+		explicit BandWriter(std::vector<Rect>* result)
+			: result(result)
+		{}
+
+		void add(int32_t top, int32_t bottom, const std::vector<Span>& spans) {
+			if (spans.empty())
+				return;
+
+			if (can_join(top, spans)) {
+				for (size_t i = previous_begin; i < result->size(); i++)
+					(*result)[i].bottom = bottom;
+				return;
+			}
+
+			previous_begin = result->size();
+			for (const Span& span : spans)
+				result->push_back({ span.left, top, span.right, bottom });
+		}
+
+	private:
+		bool can_join(int32_t top, const std::vector<Span>& spans) const {
+			if (previous_begin == result->size() || result->back().bottom != top)
+				return false;
+
+			if (result->size() - previous_begin != spans.size())
+				return false;
+
+			for (size_t i = 0; i < spans.size(); i++) {
+				const Rect& rect = (*result)[previous_begin + i];
+				if (rect.left != spans[i].left || rect.right != spans[i].right)
+					return false;
+			}
+
+			return true;
+		}
+
+	private:
+		std::vector<Rect>* result;
+		// First rect of the last band.
+		size_t previous_begin = 0;
+	};
+
+	// Spans of a that aren't covered by b.
+	void subtract_spans(const std::vector<Span>& a, const std::vector<Span>& b, std::vector<Span>* result) {
+		std::vector<Span> inverted;
+		result->clear();
+		for (const Span& span : a) {
+			invert_spans(span.left, span.right, b, &inverted);
+			result->insert(result->end(), inverted.begin(), inverted.end());
+		}
+	}
+
+	struct Edge {
+		Point from;
+		Point to;
+	};
+
+	bool is_less(const Point& a, const Point& b) {
+		return a.y < b.y || (a.y == b.y && a.x < b.x);
+	}
+
+	bool is_equal(const Point& a, const Point& b) {
+		return a.x == b.x && a.y == b.y;
+	}
+
+	// b lies on the straight line from a to c.
+	bool is_collinear(const Point& a, const Point& b, const Point& c) {
+		return (a.x == b.x && b.x == c.x) || (a.y == b.y && b.y == c.y);
+	}
+
+	// Horizontal edges between the spans above and below y. Inside is on the
+	// right of an edge: left to right over the area below, right to left under
+	// the area above.
+	void add_horizontal_edges(int32_t y, const std::vector<Span>& above, const std::vector<Span>& below, std::vector<Edge>* edges) {
+		std::vector<Span> difference;
+
+		subtract_spans(below, above, &difference);
+		for (const Span& span : difference)
+			edges->push_back({ { span.left, y }, { span.right, y } });
+
+		subtract_spans(above, below, &difference);
+		for (const Span& span : difference)
+			edges->push_back({ { span.right, y }, { span.left, y } });
+	}
+
+	void get_band_edges(const std::vector<Rect>& rects, std::vector<int32_t>* edges) {
+		edges->clear();
+		edges->reserve(rects.size() * 2);
+		for (const Rect& rect : rects) {
+			if (acrylic::is_empty(rect))
+				continue;
+
+			edges->push_back(rect.top);
+			edges->push_back(rect.bottom);
+		}
+
+		std::sort(edges->begin(), edges->end());
+		edges->erase(std::unique(edges->begin(), edges->end()), edges->end());
+	}
+}
+
+namespace acrylic {
+
+bool is_empty(const Rect& rect) {
+	return rect.right <= rect.left || rect.bottom <= rect.top;
+}
+
+Rect intersect(const Rect& a, const Rect& b) {
+	return {
+		std::max(a.left, b.left),
+		std::max(a.top, b.top),
+		std::min(a.right, b.right),
+		std::min(a.bottom, b.bottom)
+	};
+}
+
+std::vector<Rect> merge_rects(const std::vector<Rect>& rects) {
+	std::vector<Rect> result;
+	std::vector<int32_t> edges;
+	std::vector<Span> spans;
+
+	get_band_edges(rects, &edges);
+
+	BandWriter writer(&result);
+	for (size_t i = 1; i < edges.size(); i++) {
+		get_band_spans(rects, edges[i - 1], edges[i], &spans);
+		writer.add(edges[i - 1], edges[i], spans);
+	}
+
+	return result;
+}
+
+std::vector<Rect> subtract_rects(const Rect& bounds, const std::vector<Rect>& rects) {
+	std::vector<Rect> result;
+	if (is_empty(bounds))
+		return result;
+
+	std::vector<Rect> clipped;
+	clipped.reserve(rects.size());
+	for (const Rect& rect : rects) {
+		Rect clip = intersect(rect, bounds);
+		if (!is_empty(clip))
+			clipped.push_back(clip);
+	}
+
+	std::vector<int32_t> edges;
+	get_band_edges(clipped, &edges);
+	edges.push_back(bounds.top);
+	edges.push_back(bounds.bottom);
+	std::sort(edges.begin(), edges.end());
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+	std::vector<Span> spans;
+	std::vector<Span> inverted;
+
+	BandWriter writer(&result);
+	for (size_t i = 1; i < edges.size(); i++) {
+		get_band_spans(clipped, edges[i - 1], edges[i], &spans);
+		invert_spans(bounds.left, bounds.right, spans, &inverted);
+		writer.add(edges[i - 1], edges[i], inverted);
+	}
+
+	return result;
+}
+
+bool contains(const std::vector<Rect>& region, const Point& point) {
+	// Bands don't overlap, so bottoms grow along with tops.
+	auto rect = std::upper_bound(region.begin(), region.end(), point.y, [](int32_t y, const Rect& r) {
+		return y < r.bottom;
+	});
+
+	for (; rect != region.end() && rect->top <= point.y; ++rect) {
+		if (point.x < rect->left)
+			return false;
+
+		if (point.x < rect->right)
+			return true;
+	}
+
+	return false;
+}
+
+std::vector<std::vector<Point>> get_outlines(const std::vector<Rect>& region) {
+	std::vector<std::vector<Point>> outlines;
+
+	// Bands of the region. Rects of a band share top and bottom.
+	struct Band {
+		int32_t top;
+		int32_t bottom;
+		std::vector<Span> spans;
+	};
+
+	std::vector<Band> bands;
+	for (const Rect& rect : region) {
+		if (is_empty(rect))
+			continue;
+
+		if (bands.empty() || bands.back().top != rect.top)
+			bands.push_back({ rect.top, rect.bottom, {} });
+
+		bands.back().spans.push_back({ rect.left, rect.right });
+	}
+
+	std::vector<Edge> edges;
+	const std::vector<Span> none;
+	for (size_t i = 0; i < bands.size(); i++) {
+		const Band& band = bands[i];
+		for (const Span& span : band.spans) {
+			edges.push_back({ { span.left, band.bottom }, { span.left, band.top } });
+			edges.push_back({ { span.right, band.top }, { span.right, band.bottom } });
+		}
+
+		bool touches_previous = i > 0 && bands[i - 1].bottom == band.top;
+		add_horizontal_edges(band.top, touches_previous ? bands[i - 1].spans : none, band.spans, &edges);
+
+		bool touches_next = i + 1 < bands.size() && bands[i + 1].top == band.bottom;
+		if (!touches_next)
+			add_horizontal_edges(band.bottom, band.spans, none, &edges);
+	}
+
+	std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+		return is_less(a.from, b.from);
+	});
+
+	std::vector<bool> used(edges.size());
+	std::vector<Point> points;
+
+	// A horizontal edge never continues another one, so it starts at a corner.
+	for (size_t start = 0; start < edges.size(); start++) {
+		if (used[start] || edges[start].from.y != edges[start].to.y)
+			continue;
+
+		points.clear();
+		size_t edge = start;
+		while (true) {
+			used[edge] = true;
+			points.push_back(edges[edge].from);
+
+			Point to = edges[edge].to;
+			if (is_equal(to, edges[start].from))
+				break;
+
+			// Regions that touch at a corner have two edges leaving it. Either
+			// one gives the same area.
+			auto next = std::lower_bound(edges.begin(), edges.end(), to, [](const Edge& e, const Point& point) {
+				return is_less(e.from, point);
+			});
+
+			while (next != edges.end() && used[next - edges.begin()])
+				++next;
+
+			// Edges that don't close up aren't from merge_rects or subtract_rects.
+			if (next == edges.end() || !is_equal(next->from, to))
+				return {};
+
+			edge = next - edges.begin();
+		}
+
+		std::vector<Point> outline;
+		outline.push_back(points[0]);
+		for (size_t i = 1; i < points.size(); i++) {
+			const Point& next = points[(i + 1) % points.size()];
+			if (!is_collinear(outline.back(), points[i], next))
+				outline.push_back(points[i]);
+		}
+
+		outlines.push_back(std::move(outline));
+	}
+
+	return outlines;
+}
+
+std::vector<Point> join_outlines(const std::vector<std::vector<Point>>& outlines) {
+	std::vector<Point> polygon;
+	for (const std::vector<Point>& outline : outlines) {
+		if (outline.empty())
+			continue;
+
+		if (polygon.empty()) {
+			polygon = outline;
+			polygon.push_back(outline[0]);
+			continue;
+		}
+
+		Point origin = polygon[0];
+		polygon.insert(polygon.end(), outline.begin(), outline.end());
+		polygon.push_back(outline[0]);
+		polygon.push_back(origin);
+	}
+
+	return polygon;
+}
+
+}
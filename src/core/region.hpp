@@ -0,0 +1,51 @@
+/**************************************************************************/
+/*  region.hpp                                                            */
+/*  Godot independent regions made of rects.                              */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "geometry.hpp"
+
+#include <vector>
+
+namespace acrylic {
+
+bool is_empty(const Rect& rect);
+Rect intersect(const Rect& a, const Rect& b);
+
+// Regions are stored like X11 and Win32 store them: the area is split into
+// horizontal bands at the top and bottom edges of the rects, the spans of
+// each band are merged, and equal bands that touch are joined. The result
+// is a list of disjoint rects sorted by top, then left, and the same area
+// always gives the same list, so two regions can be compared with ==.
+
+// The union of the rects.
+std::vector<Rect> merge_rects(const std::vector<Rect>& rects);
+
+// bounds minus the union of the rects.
+std::vector<Rect> subtract_rects(const Rect& bounds, const std::vector<Rect>& rects);
+
+// Whether a region returned by merge_rects or subtract_rects contains the
+// point. Bands are found with a binary search.
+bool contains(const std::vector<Rect>& region, const Point& point);
+
+// Boundaries of a region returned by merge_rects or subtract_rects, one
+// closed polygon per boundary including the holes. Only the corners are kept.
+// With y pointing down outer boundaries go clockwise and holes counterclockwise.
+// Empty if the region isn't normalized and its edges don't close up.
+std::vector<std::vector<Point>> get_outlines(const std::vector<Rect>& region);
+
+// One polygon that covers the same area as the outlines under the even-odd
+// rule, for APIs that take a single polygon. The first point is joined to
+// every other outline by a bridge walked there and back, which adds no area.
+std::vector<Point> join_outlines(const std::vector<std::vector<Point>>& outlines);
+
+}
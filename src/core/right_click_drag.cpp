@@ -0,0 +1,58 @@
+/**************************************************************************/
+/*  right_click_drag.cpp                                                  */
+/*  Drag window by right click.                                           */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "right_click_drag.hpp"
+
+#include <cstdlib>
+
+namespace acrylic {
+
+void RightClickDrag::press(const Point& screen_position) {
+	pressed = true;
+	dragging = false;
+	position = screen_position;
+	traveled = {};
+}
+
+void RightClickDrag::release() {
+	pressed = false;
+	dragging = false;
+}
+
+bool RightClickDrag::is_pressed() const {
+	return pressed;
+}
+
+bool RightClickDrag::is_dragging() const {
+	return dragging;
+}
+
+bool RightClickDrag::move(const Point& screen_position, Point* delta) {
+	if (!pressed)
+		return false;
+
+	delta->x = screen_position.x - position.x;
+	delta->y = screen_position.y - position.y;
+
+	if (!dragging) {
+		traveled.x += std::abs(delta->x);
+		traveled.y += std::abs(delta->y);
+
+		dragging = traveled.x > DRAG_THRESHOLD || traveled.y > DRAG_THRESHOLD;
+	}
+
+	position = screen_position;
+
+	return dragging;
+}
+
+}
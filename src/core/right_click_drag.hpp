@@ -0,0 +1,42 @@
+/**************************************************************************/
+/*  right_click_drag.hpp                                                  */
+/*  Drag window by right click.                                           */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "geometry.hpp"
+
+namespace acrylic {
+
+// The window starts moving only after the cursor has traveled more than
+// DRAG_THRESHOLD pixels so that a right click still opens context menus.
+class RightClickDrag {
+public:
+	static constexpr int32_t DRAG_THRESHOLD = 10;
+
+public:
+	void press(const Point& screen_position);
+	void release();
+
+	bool is_pressed() const;
+	bool is_dragging() const;
+
+	// Returns true if the window must be moved by delta.
+	bool move(const Point& screen_position, Point* delta);
+
+private:
+	bool pressed = false;
+	bool dragging = false;
+	Point position;
+	Point traveled;
+};
+
+}
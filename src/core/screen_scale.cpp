@@ -0,0 +1,35 @@
+/**************************************************************************/
+/*  screen_scale.cpp                                                      */
+/*  Godot independent scale of a screen from its DPI.                     */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "screen_scale.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	constexpr float REFERENCE_DPI = 96;
+	constexpr float STEPS_PER_SCALE = 4;
+	// Part of a step the DPI must reach to round up, e.g. 115.2 DPI for 125%.
+	constexpr float STEP_THRESHOLD = 0.8f;
+}
+
+namespace acrylic {
+
+float get_dpi_scale(int32_t dpi) {
+	if (dpi <= 0)
+		return 1;
+
+	float steps = std::floor(dpi / REFERENCE_DPI * STEPS_PER_SCALE + (1 - STEP_THRESHOLD));
+	return std::max(steps / STEPS_PER_SCALE, 1.0f);
+}
+
+}
@@ -0,0 +1,25 @@
+/**************************************************************************/
+/*  screen_scale.hpp                                                      */
+/*  Godot independent scale of a screen from its DPI.                     */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace acrylic {
+
+// Scale of a screen relative to 96 DPI in 25% steps like the Windows display
+// settings. The next step is taken only close to its DPI, and the scale is
+// never below 1: the physical DPI of common desktop monitors is 80 to 115,
+// which is meant to be 100%. Returns 1 if the DPI isn't known (0 or less).
+float get_dpi_scale(int32_t dpi);
+
+}
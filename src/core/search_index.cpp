@@ -0,0 +1,296 @@
+/**************************************************************************/
+/*  search_index.cpp                                                      */
+/*  Typeahead search over item texts.                                     */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "search_index.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+namespace {
+	uint32_t get_trigram(const char* text) {
+		return (static_cast<uint32_t>(static_cast<unsigned char>(text[0])) << 16)
+			| (static_cast<uint32_t>(static_cast<unsigned char>(text[1])) << 8)
+			| static_cast<uint32_t>(static_cast<unsigned char>(text[2]));
+	}
+
+	bool is_repeated(const std::string& text, std::string_view character) {
+		if (text.empty() || character.size() != 1)
+			return false;
+
+		return std::all_of(text.begin(), text.end(), [character](char c) { return c == character[0]; });
+	}
+}
+
+namespace acrylic {
+
+void SearchIndex::clear() {
+	built = false;
+	texts.clear();
+	sorted.clear();
+	positions.clear();
+	trigram_keys.clear();
+	trigram_ends.clear();
+	trigram_items.clear();
+}
+
+void SearchIndex::build(const ItemTexts& p_texts) {
+	clear();
+
+	uint32_t count = static_cast<uint32_t>(p_texts.size());
+	texts.reserve(count, 0);
+	for (uint32_t item = 0; item < count; item++)
+		texts.add(fold(p_texts.get(item)));
+
+	sorted.resize(count);
+	std::iota(sorted.begin(), sorted.end(), 0);
+	std::stable_sort(sorted.begin(), sorted.end(), [this](uint32_t a, uint32_t b) {
+		return texts.get(a) < texts.get(b);
+	});
+
+	positions.resize(count);
+	for (uint32_t position = 0; position < count; position++)
+		positions[sorted[position]] = position;
+
+	// (trigram, item) pairs are generated in item order.
+	size_t pair_count = 0;
+	for (uint32_t item = 0; item < count; item++)
+		pair_count += texts.get(item).size() >= 3 ? texts.get(item).size() - 2 : 0;
+
+	std::vector<uint64_t> pairs;
+	pairs.reserve(pair_count);
+	for (uint32_t item = 0; item < count; item++) {
+		std::string_view text = texts.get(item);
+		for (size_t i = 0; i + 3 <= text.size(); i++)
+			pairs.push_back(static_cast<uint64_t>(get_trigram(text.data() + i)) << 32 | item);
+	}
+
+	// A stable radix sort by the 24 bit trigram keeps the items of each
+	// trigram in item order. It's several times faster than std::sort here.
+	std::vector<uint64_t> buffer(pairs.size());
+	for (int shift = 32; shift < 56; shift += 8) {
+		size_t offsets[257] = {};
+		for (uint64_t pair : pairs)
+			offsets[((pair >> shift) & 255) + 1]++;
+
+		for (int i = 0; i < 256; i++)
+			offsets[i + 1] += offsets[i];
+
+		for (uint64_t pair : pairs)
+			buffer[offsets[(pair >> shift) & 255]++] = pair;
+
+		pairs.swap(buffer);
+	}
+
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+	trigram_items.reserve(pairs.size());
+	for (uint64_t pair : pairs) {
+		uint32_t key = static_cast<uint32_t>(pair >> 32);
+		if (trigram_keys.empty() || trigram_keys.back() != key) {
+			if (!trigram_keys.empty())
+				trigram_ends.push_back(static_cast<uint32_t>(trigram_items.size()));
+			trigram_keys.push_back(key);
+		}
+
+		trigram_items.push_back(static_cast<uint32_t>(pair));
+	}
+
+	if (!trigram_keys.empty())
+		trigram_ends.push_back(static_cast<uint32_t>(trigram_items.size()));
+
+	built = true;
+}
+
+bool SearchIndex::is_built() const {
+	return built;
+}
+
+size_t SearchIndex::size() const {
+	return texts.size();
+}
+
+PrefixRange SearchIndex::find_prefix(std::string_view query) const {
+	return refine_prefix({ 0, sorted.size() }, query);
+}
+
+PrefixRange SearchIndex::refine_prefix(const PrefixRange& range, std::string_view query) const {
+	std::string folded = fold(query);
+
+	auto begin = sorted.begin() + range.first;
+	auto end = sorted.begin() + range.last;
+
+	auto first = std::lower_bound(begin, end, folded, [this](uint32_t item, const std::string& value) {
+		return texts.get(item) < value;
+	});
+
+	// The items that start with the query come first.
+	auto last = std::partition_point(first, end, [this, &folded](uint32_t item) {
+		return has_prefix(item, folded);
+	});
+
+	return { static_cast<size_t>(first - sorted.begin()), static_cast<size_t>(last - sorted.begin()) };
+}
+
+uint32_t SearchIndex::get_sorted_item(size_t position) const {
+	return sorted[position];
+}
+
+size_t SearchIndex::get_sorted_position(uint32_t item) const {
+	return positions[item];
+}
+
+void SearchIndex::find_substring(std::string_view query, std::vector<uint32_t>* matches) const {
+	std::string folded = fold(query);
+
+	// Too short for trigrams.
+	if (folded.size() < 3) {
+		for (uint32_t item = 0; item < texts.size(); item++) {
+			if (has_substring(item, folded))
+				matches->push_back(item);
+		}
+
+		return;
+	}
+
+	// Only the items of the rarest trigram need to be checked.
+	size_t candidates_begin = 0;
+	size_t candidates_end = SIZE_MAX;
+	for (size_t i = 0; i + 3 <= folded.size(); i++) {
+		auto it = std::lower_bound(trigram_keys.begin(), trigram_keys.end(), get_trigram(folded.data() + i));
+		if (it == trigram_keys.end() || *it != get_trigram(folded.data() + i))
+			return;
+
+		size_t key = static_cast<size_t>(it - trigram_keys.begin());
+		size_t begin = key ? trigram_ends[key - 1] : 0;
+		size_t end = trigram_ends[key];
+		if (end - begin < candidates_end - candidates_begin) {
+			candidates_begin = begin;
+			candidates_end = end;
+		}
+	}
+
+	for (size_t i = candidates_begin; i < candidates_end; i++) {
+		if (has_substring(trigram_items[i], folded))
+			matches->push_back(trigram_items[i]);
+	}
+}
+
+bool SearchIndex::has_prefix(uint32_t item, std::string_view query) const {
+	std::string_view text = texts.get(item);
+	return text.size() >= query.size() && text.compare(0, query.size(), query) == 0;
+}
+
+bool SearchIndex::has_substring(uint32_t item, std::string_view query) const {
+	return texts.get(item).find(query) != std::string_view::npos;
+}
+
+std::string SearchIndex::fold(std::string_view text) {
+	std::string folded(text);
+	for (char& c : folded) {
+		if (c >= 'A' && c <= 'Z')
+			c = static_cast<char>(c - 'A' + 'a');
+	}
+
+	return folded;
+}
+
+int32_t Typeahead::type(const SearchIndex& index, std::string_view character, uint64_t now, int32_t current) {
+	if (now - last_time > TIMEOUT)
+		reset();
+
+	last_time = now;
+
+	std::string folded = SearchIndex::fold(character);
+	std::string next = query + folded;
+
+	// The matches of the longer query are among the current ones.
+	if (substring) {
+		std::vector<uint32_t> refined;
+		for (uint32_t item : matches) {
+			if (index.has_substring(item, next))
+				refined.push_back(item);
+		}
+
+		query = next;
+		matches = std::move(refined);
+
+		return pick_substring(current);
+	}
+
+	PrefixRange refined = query.empty() ? index.find_prefix(next) : index.refine_prefix(range, next);
+	if (!refined.is_empty()) {
+		query = next;
+		range = refined;
+
+		return pick_prefix(index, current, false);
+	}
+
+	if (is_repeated(query, folded) && !range.is_empty())
+		return pick_prefix(index, current, true);
+
+	query = next;
+	range = refined;
+
+	if (query.size() >= 3) {
+		index.find_substring(query, &matches);
+		substring = true;
+
+		return pick_substring(current);
+	}
+
+	return -1;
+}
+
+void Typeahead::reset() {
+	query.clear();
+	range = {};
+	matches.clear();
+	substring = false;
+}
+
+const std::string& Typeahead::get_query() const {
+	return query;
+}
+
+int32_t Typeahead::pick_prefix(const SearchIndex& index, int32_t current, bool next) const {
+	if (range.is_empty())
+		return -1;
+
+	if (current >= 0 && static_cast<size_t>(current) < index.size()) {
+		size_t position = index.get_sorted_position(static_cast<uint32_t>(current));
+		if (position >= range.first && position < range.last) {
+			if (!next)
+				return current;
+
+			position = position + 1 < range.last ? position + 1 : range.first;
+			return static_cast<int32_t>(index.get_sorted_item(position));
+		}
+	}
+
+	return static_cast<int32_t>(index.get_sorted_item(range.first));
+}
+
+// The first match at or after current, wrapping around.
+int32_t Typeahead::pick_substring(int32_t current) const {
+	if (matches.empty())
+		return -1;
+
+	if (current < 0)
+		return static_cast<int32_t>(matches.front());
+
+	auto it = std::lower_bound(matches.begin(), matches.end(), static_cast<uint32_t>(current));
+
+	return static_cast<int32_t>(it == matches.end() ? matches.front() : *it);
+}
+
+}
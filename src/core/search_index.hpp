@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*  search_index.hpp                                                      */
+/*  Typeahead search over item texts.                                     */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "item_texts.hpp"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace acrylic {
+
+// Items whose text starts with a query are next to each other in the
+// items sorted by text. first and last are positions in that order.
+struct PrefixRange {
+	size_t first = 0;
+	size_t last = 0;
+
+	bool is_empty() const { return first == last; }
+};
+
+// Case insensitive (ASCII only) prefix and substring search over item texts.
+// Prefix queries binary search the items sorted by text. Substring queries
+// check only the items that contain the rarest trigram of the query.
+class SearchIndex {
+public:
+	void clear();
+	void build(const ItemTexts& texts);
+	bool is_built() const;
+
+	size_t size() const;
+
+	PrefixRange find_prefix(std::string_view query) const;
+	// Narrows the range of a shorter prefix of query.
+	PrefixRange refine_prefix(const PrefixRange& range, std::string_view query) const;
+
+	uint32_t get_sorted_item(size_t position) const;
+	size_t get_sorted_position(uint32_t item) const;
+
+	// Appends the matching items in item order.
+	void find_substring(std::string_view query, std::vector<uint32_t>* matches) const;
+
+	// query must be folded.
+	bool has_prefix(uint32_t item, std::string_view query) const;
+	bool has_substring(uint32_t item, std::string_view query) const;
+
+	static std::string fold(std::string_view text);
+
+private:
+	bool built = false;
+	// Lowercase texts.
+	ItemTexts texts;
+	// Items sorted by text and the position of each item in that order.
+	std::vector<uint32_t> sorted;
+	std::vector<uint32_t> positions;
+	// Items that contain trigram_keys[i] are trigram_items[trigram_ends[i - 1]..trigram_ends[i]]
+	// in item order. Flat arrays build much faster than a map of vectors.
+	std::vector<uint32_t> trigram_keys;
+	std::vector<uint32_t> trigram_ends;
+	std::vector<uint32_t> trigram_items;
+};
+
+// Turns typed characters into the item to select:
+//   Characters typed within TIMEOUT refine the query.
+//   Typing the first character again cycles through the items starting with it.
+//   Prefix matches win and are visited in text order. Queries of 3 and more
+//   characters fall back to substrings, which are visited in item order.
+class Typeahead {
+public:
+	static constexpr uint64_t TIMEOUT = 1000000; // usec
+
+public:
+	// character is UTF-8. current is the selected item or -1.
+	// Returns the item to select or -1 if nothing matches.
+	int32_t type(const SearchIndex& index, std::string_view character, uint64_t now, int32_t current);
+	void reset();
+
+	const std::string& get_query() const;
+
+private:
+	// Stays on current if it matches unless next is true.
+	int32_t pick_prefix(const SearchIndex& index, int32_t current, bool next) const;
+	int32_t pick_substring(int32_t current) const;
+
+private:
+	std::string query;
+	PrefixRange range;
+	std::vector<uint32_t> matches;
+	bool substring = false;
+	uint64_t last_time = 0;
+};
+
+}
@@ -0,0 +1,62 @@
+/**************************************************************************/
+/*  style.cpp                                                             */
+/*  Godot independent style enums and color adjustment.                   */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "style.hpp"
+
+namespace acrylic {
+
+StyleColors adjust_colors(const Rgba& base_color) {
+	float luminance = base_color.get_luminance();
+	Rgba border_tint = Rgba(luminance, luminance, luminance) * 0.75f;
+
+	StyleColors colors;
+	colors.border_color = base_color.lerp(border_tint, 1 - base_color.a);
+	colors.title_bar_color = colors.border_color;
+	colors.text_color = luminance < 0.65f ? Rgba(1, 1, 1) : Rgba(0, 0, 0);
+	colors.clear_color = base_color.darkened(0.85f);
+
+	return colors;
+}
+
+int get_dwm_backdrop_type(Backdrop backdrop) {
+	switch (backdrop) {
+	case BACKDROP_SOLID:
+		return 0; // DWMSBT_AUTO
+	case BACKDROP_TRANSPARENT:
+		return 1; // DWMSBT_NONE
+	case BACKDROP_ACRYLIC:
+		return 3; // DWMSBT_TRANSIENTWINDOW
+	case BACKDROP_MICA:
+		return 2; // DWMSBT_MAINWINDOW
+	case BACKDROP_TABBED:
+		return 4; // DWMSBT_TABBEDWINDOW
+	}
+
+	return 0;
+}
+
+int get_dwm_corner_preference(Corner corner) {
+	switch (corner) {
+	case CORNER_DEFAULT:
+		return 0; // DWMWCP_DEFAULT
+	case CORNER_DONT_ROUND:
+		return 1; // DWMWCP_DONOTROUND
+	case CORNER_ROUND:
+		return 2; // DWMWCP_ROUND
+	case CORNER_ROUND_SMALL:
+		return 3; // DWMWCP_ROUNDSMALL
+	}
+
+	return 0;
+}
+
+}
@@ -0,0 +1,56 @@
+/**************************************************************************/
+/*  style.hpp                                                             */
+/*  Godot independent style enums and color adjustment.                   */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "color.hpp"
+
+namespace acrylic {
+
+// Same values as the enums of AcrylicWindow.
+enum Frame {
+	FRAME_DEFAULT,
+	FRAME_BORDERLESS,
+	FRAME_CUSTOM
+};
+
+enum Backdrop {
+	BACKDROP_SOLID,
+	BACKDROP_TRANSPARENT,
+	BACKDROP_ACRYLIC,
+	BACKDROP_MICA,
+	BACKDROP_TABBED
+};
+
+enum Corner {
+	CORNER_DEFAULT,
+	CORNER_DONT_ROUND,
+	CORNER_ROUND,
+	CORNER_ROUND_SMALL
+};
+
+struct StyleColors {
+	Rgba border_color;
+	Rgba title_bar_color;
+	Rgba text_color;
+	Rgba clear_color;
+};
+
+// Derives the rest of the colors from the base color when auto_colors is on.
+StyleColors adjust_colors(const Rgba& base_color);
+
+// Values of DWM_SYSTEMBACKDROP_TYPE and DWM_WINDOW_CORNER_PREFERENCE.
+// They are duplicated here to keep this library free of Windows headers.
+int get_dwm_backdrop_type(Backdrop backdrop);
+int get_dwm_corner_preference(Corner corner);
+
+}
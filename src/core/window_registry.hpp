@@ -0,0 +1,63 @@
+/**************************************************************************/
+/*  window_registry.hpp                                                   */
+/*  Per-window state with O(1) lookup by window handle or id.             */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+namespace acrylic {
+
+// Keys are native window handles or Godot window ids cast to uint64_t.
+// Entries are never moved, so the pointers returned by insert and find
+// stay valid until the entry is erased.
+template <typename T>
+class WindowRegistry {
+public:
+	// Returns nullptr if the key is already registered.
+	T* insert(uint64_t key, T&& value) {
+		auto result = entries.emplace(key, std::move(value));
+		return result.second ? &result.first->second : nullptr;
+	}
+
+	T* find(uint64_t key) {
+		auto entry = entries.find(key);
+		return entry != entries.end() ? &entry->second : nullptr;
+	}
+
+	const T* find(uint64_t key) const {
+		auto entry = entries.find(key);
+		return entry != entries.end() ? &entry->second : nullptr;
+	}
+
+	bool erase(uint64_t key) {
+		return entries.erase(key) != 0;
+	}
+
+	size_t size() const {
+		return entries.size();
+	}
+
+	// f(key, value). f must not insert or erase.
+	template <typename F>
+	void for_each(F&& f) {
+		for (auto& entry : entries)
+			f(entry.first, entry.second);
+	}
+
+private:
+	std::unordered_map<uint64_t, T> entries;
+};
+
+}
@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  x11_hints.cpp                                                         */
+/*  Godot independent X11 window hints and their batching.                */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "x11_hints.hpp"
+
+namespace acrylic {
+
+MotifHints get_motif_hints(Frame frame) {
+	MotifHints hints;
+	hints.flags = MOTIF_HINTS_DECORATIONS;
+	hints.decorations = frame == FRAME_DEFAULT ? MOTIF_DECORATIONS_ALL : 0;
+
+	return hints;
+}
+
+bool X11PropertyBatch::set_frame(Frame p_frame) {
+	// Frames that map to the same hints are the same for X11.
+	bool same_hints = get_motif_hints(p_frame).decorations == get_motif_hints(written_frame).decorations;
+	frame = p_frame;
+	update(X11_PROPERTY_MOTIF_HINTS, !same_hints);
+
+	return (dirty & X11_PROPERTY_MOTIF_HINTS) != 0;
+}
+
+bool X11PropertyBatch::set_above(bool p_above) {
+	above = p_above;
+	update(X11_PROPERTY_STATE_ABOVE, above != written_above);
+
+	return (dirty & X11_PROPERTY_STATE_ABOVE) != 0;
+}
+
+bool X11PropertyBatch::set_window_type(X11WindowType p_window_type) {
+	window_type = p_window_type;
+	update(X11_PROPERTY_WINDOW_TYPE, window_type != written_window_type);
+
+	return (dirty & X11_PROPERTY_WINDOW_TYPE) != 0;
+}
+
+bool X11PropertyBatch::set_opaque_region(const std::vector<Rect>& p_opaque_region) {
+	opaque_region = p_opaque_region;
+	update(X11_PROPERTY_OPAQUE_REGION, opaque_region != written_opaque_region);
+
+	return (dirty & X11_PROPERTY_OPAQUE_REGION) != 0;
+}
+
+bool X11PropertyBatch::set_blur_region(bool p_blur, const std::vector<Rect>& p_blur_region) {
+	blur = p_blur;
+	if (blur)
+		blur_region = p_blur_region;
+	else
+		blur_region.clear();
+
+	update(X11_PROPERTY_BLUR_REGION, blur != written_blur || blur_region != written_blur_region);
+
+	return (dirty & X11_PROPERTY_BLUR_REGION) != 0;
+}
+
+void X11PropertyBatch::invalidate() {
+	written = 0;
+	dirty = known;
+}
+
+uint32_t X11PropertyBatch::get_dirty() const {
+	return dirty;
+}
+
+uint32_t X11PropertyBatch::take_dirty() {
+	uint32_t result = dirty;
+
+	written |= dirty;
+	written_frame = frame;
+	written_above = above;
+	written_window_type = window_type;
+	if (result & X11_PROPERTY_OPAQUE_REGION)
+		written_opaque_region = opaque_region;
+	if (result & X11_PROPERTY_BLUR_REGION) {
+		written_blur = blur;
+		written_blur_region = blur_region;
+	}
+	dirty = 0;
+
+	return result;
+}
+
+Frame X11PropertyBatch::get_frame() const {
+	return frame;
+}
+
+bool X11PropertyBatch::is_above() const {
+	return above;
+}
+
+X11WindowType X11PropertyBatch::get_window_type() const {
+	return window_type;
+}
+
+const std::vector<Rect>& X11PropertyBatch::get_opaque_region() const {
+	return opaque_region;
+}
+
+bool X11PropertyBatch::has_blur() const {
+	return blur;
+}
+
+const std::vector<Rect>& X11PropertyBatch::get_blur_region() const {
+	return blur_region;
+}
+
+void X11PropertyBatch::update(X11Property property, bool changed) {
+	known |= property;
+
+	// A property that has never been written is dirty whatever its value.
+	if (changed || !(written & property))
+		dirty |= property;
+	else
+		dirty &= ~static_cast<uint32_t>(property);
+}
+
+}
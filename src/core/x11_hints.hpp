@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  x11_hints.hpp                                                         */
+/*  Godot independent X11 window hints and their batching.                */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "geometry.hpp"
+#include "style.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace acrylic {
+
+// _MOTIF_WM_HINTS. Xlib sends format 32 properties as longs,
+// so the native code widens these before XChangeProperty.
+struct MotifHints {
+	uint32_t flags = 0;
+	uint32_t functions = 0;
+	uint32_t decorations = 0;
+	int32_t input_mode = 0;
+	uint32_t status = 0;
+};
+
+constexpr uint32_t MOTIF_HINTS_DECORATIONS = 1u << 1;
+constexpr uint32_t MOTIF_DECORATIONS_ALL = 1u << 0;
+
+// Only the default frame keeps the decorations of the window manager.
+MotifHints get_motif_hints(Frame frame);
+
+enum X11WindowType {
+	X11_WINDOW_TYPE_NORMAL,
+	X11_WINDOW_TYPE_DIALOG,
+	X11_WINDOW_TYPE_UTILITY
+};
+
+// One bit per property.
+enum X11Property {
+	X11_PROPERTY_MOTIF_HINTS = 1u << 0,
+	X11_PROPERTY_STATE_ABOVE = 1u << 1,
+	X11_PROPERTY_WINDOW_TYPE = 1u << 2,
+	X11_PROPERTY_OPAQUE_REGION = 1u << 3,
+	X11_PROPERTY_BLUR_REGION = 1u << 4
+};
+
+// The values of the X11 properties of one window and the ones that have
+// changed since the last flush. Setting the same value twice or setting
+// a value back before the flush doesn't dirty the property, so a frame
+// of style changes ends up as at most one write per property.
+class X11PropertyBatch {
+public:
+	// Return true if the property became dirty.
+	bool set_frame(Frame p_frame);
+	bool set_above(bool p_above);
+	bool set_window_type(X11WindowType p_window_type);
+	// Regions are in window pixels, as returned by merge_rects/subtract_rects.
+	bool set_opaque_region(const std::vector<Rect>& p_opaque_region);
+	// Without blur the property is removed.
+	bool set_blur_region(bool p_blur, const std::vector<Rect>& p_blur_region);
+
+	// Makes the next flush write all the known properties again,
+	// e.g. after the window manager has been replaced.
+	void invalidate();
+
+	uint32_t get_dirty() const;
+	// Returns the dirty properties and marks them as written.
+	uint32_t take_dirty();
+
+	Frame get_frame() const;
+	bool is_above() const;
+	X11WindowType get_window_type() const;
+	const std::vector<Rect>& get_opaque_region() const;
+	bool has_blur() const;
+	const std::vector<Rect>& get_blur_region() const;
+
+private:
+	void update(X11Property property, bool changed);
+
+private:
+	Frame frame = FRAME_DEFAULT;
+	bool above = false;
+	X11WindowType window_type = X11_WINDOW_TYPE_NORMAL;
+	std::vector<Rect> opaque_region;
+	bool blur = false;
+	std::vector<Rect> blur_region;
+
+	// The properties that have a value.
+	uint32_t known = 0;
+	// The properties whose values differ from the written ones.
+	uint32_t dirty = 0;
+
+	// The written values, to undo dirtiness when a value is set back.
+	Frame written_frame = FRAME_DEFAULT;
+	bool written_above = false;
+	X11WindowType written_window_type = X11_WINDOW_TYPE_NORMAL;
+	std::vector<Rect> written_opaque_region;
+	bool written_blur = false;
+	std::vector<Rect> written_blur_region;
+	uint32_t written = 0;
+};
+
+}
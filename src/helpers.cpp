@@ -11,24 +11,39 @@
 /**************************************************************************/
 
 #include "helpers.hpp"
+#include "logger.hpp"
+#include "trace.hpp"
 
 #include <godot_cpp/classes/control.hpp>
 #include <godot_cpp/classes/display_server.hpp>
 #include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/popup.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/classes/rendering_server.hpp>
 #include <godot_cpp/classes/window.hpp>
 #include <godot_cpp/core/error_macros.hpp>
 
-
 #include <cstdarg>
-#include <ctime>
-#include <type_traits>
 
 using namespace godot;
 
 namespace {
-	const char PRINT_CATEGORY[] = "helpers";
+	constexpr char PRINT_CATEGORY[] = "helpers";
+
+	String get_log_setting_name(int category) {
+		return String("acrylic_window/logging/") + LOG_CATEGORY_NAMES[category];
+	}
+
+	void load_log_settings() {
+		ProjectSettings* project_settings = ProjectSettings::get_singleton();
+		if (!project_settings)
+			return;
+
+		for (int i = 0; i < LOG_CATEGORY_MAX; i++) {
+			int64_t mask = project_settings->get_setting(get_log_setting_name(i), static_cast<int64_t>(LOG_MASK_ALL));
+			log_set_mask(static_cast<LogCategory>(i), static_cast<uint32_t>(mask));
+		}
+	}
 }
 
 namespace godot {
@@ -43,7 +58,45 @@ bool is_editor() {
 	return engine->is_editor_hint();
 }
 
+void register_log_settings() {
+	ProjectSettings* project_settings = ProjectSettings::get_singleton();
+	if (!project_settings) {
+		print_error("Failed to get project settings.");
+		return;
+	}
+
+	for (int i = 0; i < LOG_CATEGORY_MAX; i++) {
+		String name = get_log_setting_name(i);
+		if (!project_settings->has_setting(name))
+			project_settings->set_setting(name, static_cast<int64_t>(LOG_MASK_ALL));
+
+		project_settings->set_initial_value(name, static_cast<int64_t>(LOG_MASK_ALL));
+
+		Dictionary property_info;
+		property_info["name"] = name;
+		property_info["type"] = Variant::INT;
+		property_info["hint"] = PROPERTY_HINT_FLAGS;
+		property_info["hint_string"] = "Error,Warning,Message,Debug";
+		project_settings->add_property_info(property_info);
+	}
+
+	load_log_settings();
+	project_settings->connect("settings_changed", callable_mp_static(&load_log_settings));
+}
+
+void unregister_log_settings() {
+	ProjectSettings* project_settings = ProjectSettings::get_singleton();
+	if (!project_settings)
+		return;
+
+	Callable callable = callable_mp_static(&load_log_settings);
+	if (project_settings->is_connected("settings_changed", callable))
+		project_settings->disconnect("settings_changed", callable);
+}
+
 bool has_popup(Window* window) {
+	TRACE_SCOPE("has_popup");
+
 	//TypedArray<Node> nodes = window->find_children("", "Popup", true, false);
 	//for (int i = 0; i < nodes.size(); i++) {
 	//	Popup* popup = Object::cast_to<Popup>(nodes[i]);
@@ -120,6 +173,8 @@ Control* find_mouse_blocking_control(Window* window, int search_depth) {
 }
 
 Control* find_mouse_blocking_control(Window* window, const Vector2& global_mouse_position, int search_depth) {
+	TRACE_SCOPE("find_mouse_blocking_control");
+
 	int child_count = window->get_child_count();
 	for (int i = 0; i < child_count; i++) {
 		Node* child = window->get_child(i);
@@ -176,67 +231,37 @@ Control* find_mouse_blocking_control(Control* control, const Vector2& global_mou
 // PRINT HELPERS
 //--------------------------------------------------------------------------
 
-#define MAKE_TIMESTAMP \
-	std::time_t time = std::time({}); \
-	char timestamp[std::size("yyyy-mm-dd hh:mm:ss")]; \
-	std::strftime(std::data(timestamp), std::size(timestamp), "%F %T", std::localtime(&time));
+// Formatting happens on the calling thread but the timestamp and the actual
+// write are done by the logger's flush thread. See logger.hpp.
 
 void print_error_impl(const char* category, const char* funcname, const char* format, ...) {
-	MAKE_TIMESTAMP;
-
-	fprintf(stderr, "\033[31;1mERROR:   ");
-	fprintf(stderr, "\033[0;31m%s [%s::%s] ", timestamp, category, funcname);
-
 	va_list argptr;
 	va_start(argptr, format);
-	vfprintf(stderr, format, argptr);
+	log_write(LOG_LEVEL_ERROR, category, funcname, format, argptr);
 	va_end(argptr);
-
-	fprintf(stderr, "\n\033[0m");
 }
 
 void print_warning_impl(const char* category, const char* funcname, const char* format, ...) {
-	MAKE_TIMESTAMP;
-
-	fprintf(stderr, "\033[33;1mWARNING: ");
-	fprintf(stderr, "\033[0;33m%s [%s::%s] ", timestamp, category, funcname);
-	
 	va_list argptr;
 	va_start(argptr, format);
-	vfprintf(stderr, format, argptr);
+	log_write(LOG_LEVEL_WARNING, category, funcname, format, argptr);
 	va_end(argptr);
 
-	fprintf(stderr, "\n\033[0m");
-
 	//_err_print_error(funcname, category, 0, format, true, true);
 }
 
 void print_message_impl(const char* category, const char* funcname, const char* format, ...) {
-	MAKE_TIMESTAMP;
-
-	fprintf(stdout, "MESSAGE: ");
-	fprintf(stdout, "%s [%s::%s] ", timestamp, category, funcname);
-
 	va_list argptr;
 	va_start(argptr, format);
-	vfprintf(stdout, format, argptr);
+	log_write(LOG_LEVEL_MESSAGE, category, funcname, format, argptr);
 	va_end(argptr);
-
-	fprintf(stdout, "\n");
 }
 
 void print_debug_impl(const char* category, const char* funcname, const char* format, ...) {
-	MAKE_TIMESTAMP;
-
-	fprintf(stdout, "\033[36;1mDEBUG:   ");
-	fprintf(stdout, "\033[0;36m%s [%s::%s] ", timestamp, category, funcname);
-
 	va_list argptr;
 	va_start(argptr, format);
-	vfprintf(stdout, format, argptr);
+	log_write(LOG_LEVEL_DEBUG, category, funcname, format, argptr);
 	va_end(argptr);
 
-	fprintf(stdout, "\n\033[0m");
-
 	//_err_print_error(funcname, category, 0, format, true, true);
 }
@@ -12,7 +12,12 @@
 
 #pragma once
 
+#include "logger.hpp"
+#include "monitors.hpp"
+#include "core/color.hpp"
+
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/color.hpp>
 
 namespace godot {
 	class Control;
@@ -22,6 +27,19 @@ namespace godot {
 
 	bool is_editor();
 
+	inline acrylic::Rgba to_rgba(const Color& color) {
+		return acrylic::Rgba(color.r, color.g, color.b, color.a);
+	}
+
+	inline Color to_color(const acrylic::Rgba& color) {
+		return Color(color.r, color.g, color.b, color.a);
+	}
+
+	// Adds Project Settings > Acrylic Window > Logging and keeps
+	// the runtime log masks in sync with them.
+	void register_log_settings();
+	void unregister_log_settings();
+
 	bool has_popup(Window* window);
 	bool has_popup(Control* control);
 
@@ -55,28 +73,50 @@ namespace godot {
 
 // EXAMPLES
 // print_debug("Control Name: %s", control->get_name().c_escape().ascii().get_data());
+//
+// PRINT_CATEGORY must be a constexpr string listed in LOG_CATEGORY_NAMES:
+// namespace {
+//     constexpr char PRINT_CATEGORY[] = "AcrylicWindow";
+// }
+//
+// Levels above ACRYLIC_LOG_LEVEL are compiled out. The others cost one
+// branch on the runtime category mask and don't evaluate their arguments
+// if the category is disabled.
+
+#ifndef ACRYLIC_LOG_LEVEL
+#ifdef _DEBUG
+#define ACRYLIC_LOG_LEVEL ::godot::LOG_LEVEL_DEBUG
+#else
+#define ACRYLIC_LOG_LEVEL ::godot::LOG_LEVEL_MESSAGE
+#endif
+#endif
 
 void print_error_impl(const char* category, const char* funcname, const char* format, ...);
 void print_warning_impl(const char* category, const char* funcname, const char* format, ...);
 void print_message_impl(const char* category, const char* funcname, const char* format, ...);
 void print_debug_impl(const char* category, const char* funcname, const char* format, ...);
 
+#define PRINT_IMPL(level, print_impl, format, ...) \
+	do { \
+		constexpr int print_category = ::godot::log_category_id(PRINT_CATEGORY); \
+		static_assert(print_category >= 0, "PRINT_CATEGORY is not listed in LOG_CATEGORY_NAMES."); \
+		if constexpr (static_cast<int>(level) <= static_cast<int>(ACRYLIC_LOG_LEVEL)) { \
+			if (::godot::log_is_enabled(static_cast<::godot::LogCategory>(print_category), level)) \
+				print_impl(PRINT_CATEGORY, __func__, format, ##__VA_ARGS__); \
+		} \
+	} while (false)
+
 #define print_error(format, ...) \
-	print_error_impl(PRINT_CATEGORY, __func__, format, ##__VA_ARGS__)
+	PRINT_IMPL(::godot::LOG_LEVEL_ERROR, print_error_impl, format, ##__VA_ARGS__)
 
 #define print_warning(format, ...) \
-	print_warning_impl(PRINT_CATEGORY, __func__, format, ##__VA_ARGS__)
+	PRINT_IMPL(::godot::LOG_LEVEL_WARNING, print_warning_impl, format, ##__VA_ARGS__)
 
 #define print_message(format, ...) \
-	print_message_impl(PRINT_CATEGORY, __func__, format, ##__VA_ARGS__)
+	PRINT_IMPL(::godot::LOG_LEVEL_MESSAGE, print_message_impl, format, ##__VA_ARGS__)
 
-#ifdef _DEBUG
 #define print_debug(format, ...) \
-	print_debug_impl(PRINT_CATEGORY, __func__, format, ##__VA_ARGS__)
-#else
-#define print_debug(format, ...) \
-	void()
-#endif
+	PRINT_IMPL(::godot::LOG_LEVEL_DEBUG, print_debug_impl, format, ##__VA_ARGS__)
 
 //--------------------------------------------------------------------------
 // PROPERTIES
@@ -109,6 +149,11 @@ void print_debug_impl(const char* category, const char* funcname, const char* fo
 	::godot::ClassDB::bind_method(::godot::D_METHOD("set_"#property_name, "p_"#property_name), &class_name::set_ ## property_name); \
 	::godot::ClassDB::add_property(#class_name, ::godot::PropertyInfo(property_type, #property_name,  ::godot::PROPERTY_HINT_ENUM, enum_values), "set_"#property_name, "get_"#property_name);
 
+#define BIND_PROPERTY_HINT(class_name, property_type, property_name, hint, hint_string) \
+	::godot::ClassDB::bind_method(::godot::D_METHOD("get_"#property_name), &class_name::get_ ## property_name); \
+	::godot::ClassDB::bind_method(::godot::D_METHOD("set_"#property_name, "p_"#property_name), &class_name::set_ ## property_name); \
+	::godot::ClassDB::add_property(#class_name, ::godot::PropertyInfo(property_type, #property_name, hint, hint_string), "set_"#property_name, "get_"#property_name);
+
 #define BIND_PROPERTY_AND_SIGNAL(class_name, property_type, property_name) \
 	BIND_PROPERTY(class_name, property_type, property_name) \
 	ADD_SIGNAL(::godot::MethodInfo(#property_name"_changed", ::godot::PropertyInfo(property_type, "new_"#property_name)));
@@ -117,8 +162,12 @@ void print_debug_impl(const char* category, const char* funcname, const char* fo
 	BIND_PROPERTY_ENUM(class_name, property_type, property_name, enum_values) \
 	ADD_SIGNAL(::godot::MethodInfo(#property_name"_changed", ::godot::PropertyInfo(property_type, "new_"#property_name)));
 
+#define BIND_PROPERTY_HINT_AND_SIGNAL(class_name, property_type, property_name, hint, hint_string) \
+	BIND_PROPERTY_HINT(class_name, property_type, property_name, hint, hint_string) \
+	ADD_SIGNAL(::godot::MethodInfo(#property_name"_changed", ::godot::PropertyInfo(property_type, "new_"#property_name)));
+
 #define BIND_FUNCTION(class_name, function_name, ...) \
 	::godot::ClassDB::bind_method(::godot::D_METHOD(#function_name, __VA_ARGS__), &class_name::function_name);
 
 #define EMIT_SIGNAL_CHANGED(property_name) \
-	emit_signal(#property_name"_changed", property_name)
\ No newline at end of file
+	(::godot::monitor_signal_emitted(), emit_signal(#property_name"_changed", property_name))
\ No newline at end of file
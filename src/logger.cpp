@@ -0,0 +1,320 @@
+/**************************************************************************/
+/*  logger.cpp                                                            */
+/*  Asynchronous logger that keeps formatting and I/O off hot paths.      */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "logger.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
+using namespace godot;
+
+namespace {
+	// Must be a power of two.
+	constexpr uint64_t LOG_CAPACITY = 1024;
+	constexpr uint64_t LOG_MASK = LOG_CAPACITY - 1;
+	constexpr size_t LOG_TEXT_SIZE = 256;
+
+	// The flush thread polls the buffer with this interval. Errors and
+	// a half full buffer wake it up immediately.
+	constexpr auto LOG_FLUSH_INTERVAL = std::chrono::milliseconds(20);
+	constexpr uint64_t LOG_WAKE_THRESHOLD = LOG_CAPACITY / 2;
+
+	// Max messages per category per second.
+	constexpr uint32_t LOG_RATE_LIMIT = 100;
+	constexpr int64_t LOG_RATE_WINDOW = 1000000000; // ns
+	constexpr size_t LOG_RATE_SLOTS = 32;
+
+	enum State {
+		STATE_IDLE,
+		STATE_RUNNING,
+		STATE_STOPPED
+	};
+
+	// A slot is free for the lap N when sequence == 2 * N
+	// and holds a message of the lap N when sequence == 2 * N + 1.
+	// This way the zero initialized buffer is ready to use.
+	struct LogEntry {
+		std::atomic<uint64_t> sequence;
+		LogLevel level;
+		const char* category;
+		const char* funcname;
+		int64_t timestamp;
+		char text[LOG_TEXT_SIZE];
+	};
+
+	struct RateLimit {
+		std::atomic<const char*> category;
+		std::atomic<int64_t> window_start;
+		std::atomic<uint32_t> count;
+		std::atomic<uint32_t> suppressed;
+	};
+
+	LogEntry entries[LOG_CAPACITY];
+	std::atomic<uint64_t> enqueue_pos;
+	std::atomic<uint64_t> dequeue_pos; // written under flush_mutex
+	std::atomic<uint64_t> dropped;
+
+	RateLimit rate_limits[LOG_RATE_SLOTS];
+
+	std::atomic<int> state;
+	std::mutex state_mutex;
+	std::mutex flush_mutex;
+	std::thread flush_thread;
+
+	std::mutex wake_mutex;
+	std::condition_variable wake;
+	bool stop_requested = false; // guarded by wake_mutex
+
+	// Used to convert monotonic timestamps to the wall clock time.
+	int64_t steady_origin = 0;
+	int64_t system_origin = 0;
+
+	int64_t now() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	void init_clock_origins() {
+		steady_origin = now();
+		system_origin = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	bool push(LogLevel level, const char* category, const char* funcname, int64_t timestamp, const char* format, va_list args) {
+		uint64_t pos = enqueue_pos.load(std::memory_order_relaxed);
+		LogEntry* entry = nullptr;
+		uint64_t free_sequence = 0;
+
+		for (;;) {
+			entry = &entries[pos & LOG_MASK];
+			free_sequence = 2 * (pos / LOG_CAPACITY);
+
+			uint64_t sequence = entry->sequence.load(std::memory_order_acquire);
+			if (sequence == free_sequence) {
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (sequence < free_sequence) {
+				// The flush thread hasn't consumed this slot yet.
+				return false;
+			}
+			else {
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		entry->level = level;
+		entry->category = category;
+		entry->funcname = funcname;
+		entry->timestamp = timestamp;
+		vsnprintf(entry->text, LOG_TEXT_SIZE, format, args);
+
+		entry->sequence.store(free_sequence + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool push_formatted(LogLevel level, const char* category, const char* funcname, int64_t timestamp, const char* format, ...) {
+		va_list args;
+		va_start(args, format);
+		bool result = push(level, category, funcname, timestamp, format, args);
+		va_end(args);
+
+		return result;
+	}
+
+	RateLimit* find_rate_limit(const char* category) {
+		size_t hash = static_cast<size_t>(reinterpret_cast<uintptr_t>(category) >> 4);
+
+		for (size_t i = 0; i < LOG_RATE_SLOTS; i++) {
+			RateLimit& limit = rate_limits[(hash + i) % LOG_RATE_SLOTS];
+
+			const char* key = limit.category.load(std::memory_order_acquire);
+			if (key == category)
+				return &limit;
+
+			if (key == nullptr) {
+				if (limit.category.compare_exchange_strong(key, category, std::memory_order_acq_rel) || key == category)
+					return &limit;
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool check_rate_limit(const char* category, int64_t timestamp) {
+		RateLimit* limit = find_rate_limit(category);
+		if (!limit)
+			return true;
+
+		int64_t window_start = limit->window_start.load(std::memory_order_relaxed);
+		if (timestamp - window_start >= LOG_RATE_WINDOW) {
+			if (limit->window_start.compare_exchange_strong(window_start, timestamp, std::memory_order_relaxed)) {
+				limit->count.store(0, std::memory_order_relaxed);
+
+				uint32_t suppressed = limit->suppressed.exchange(0, std::memory_order_relaxed);
+				if (suppressed && !push_formatted(LOG_LEVEL_WARNING, category, "logger", timestamp, "Suppressed %u messages.", suppressed))
+					dropped.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		if (limit->count.fetch_add(1, std::memory_order_relaxed) < LOG_RATE_LIMIT)
+			return true;
+
+		limit->suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	void write_entry(const LogEntry& entry) {
+		std::time_t time = static_cast<std::time_t>((system_origin + (entry.timestamp - steady_origin)) / 1000000000);
+		char timestamp[std::size("yyyy-mm-dd hh:mm:ss")];
+		std::strftime(std::data(timestamp), std::size(timestamp), "%F %T", std::localtime(&time));
+
+		switch (entry.level) {
+		case LOG_LEVEL_ERROR:
+			fprintf(stderr, "\033[31;1mERROR:   \033[0;31m%s [%s::%s] %s\n\033[0m", timestamp, entry.category, entry.funcname, entry.text);
+			break;
+		case LOG_LEVEL_WARNING:
+			fprintf(stderr, "\033[33;1mWARNING: \033[0;33m%s [%s::%s] %s\n\033[0m", timestamp, entry.category, entry.funcname, entry.text);
+			break;
+		case LOG_LEVEL_MESSAGE:
+			fprintf(stdout, "MESSAGE: %s [%s::%s] %s\n", timestamp, entry.category, entry.funcname, entry.text);
+			break;
+		case LOG_LEVEL_DEBUG:
+			fprintf(stdout, "\033[36;1mDEBUG:   \033[0;36m%s [%s::%s] %s\n\033[0m", timestamp, entry.category, entry.funcname, entry.text);
+			break;
+		}
+	}
+
+	// Must be called with flush_mutex locked.
+	void flush_entries() {
+		for (;;) {
+			uint64_t pos = dequeue_pos.load(std::memory_order_relaxed);
+			LogEntry& entry = entries[pos & LOG_MASK];
+			uint64_t full_sequence = 2 * (pos / LOG_CAPACITY) + 1;
+			if (entry.sequence.load(std::memory_order_acquire) != full_sequence)
+				break;
+
+			write_entry(entry);
+
+			entry.sequence.store(full_sequence + 1, std::memory_order_release);
+			dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+		}
+
+		uint64_t dropped_count = dropped.exchange(0, std::memory_order_relaxed);
+		if (dropped_count)
+			fprintf(stderr, "\033[33;1mWARNING: \033[0;33m[logger] Dropped %llu messages because the log buffer is full.\n\033[0m", static_cast<unsigned long long>(dropped_count));
+
+		fflush(stdout);
+		fflush(stderr);
+	}
+
+	void flush_loop() {
+		std::unique_lock<std::mutex> lock(wake_mutex);
+		while (!stop_requested) {
+			wake.wait_for(lock, LOG_FLUSH_INTERVAL);
+			lock.unlock();
+			{
+				std::lock_guard<std::mutex> guard(flush_mutex);
+				flush_entries();
+			}
+			lock.lock();
+		}
+	}
+
+	int ensure_started() {
+		int current_state = state.load(std::memory_order_acquire);
+		if (current_state != STATE_IDLE)
+			return current_state;
+
+		std::lock_guard<std::mutex> guard(state_mutex);
+
+		current_state = state.load(std::memory_order_relaxed);
+		if (current_state != STATE_IDLE)
+			return current_state;
+
+		init_clock_origins();
+		flush_thread = std::thread(flush_loop);
+
+		state.store(STATE_RUNNING, std::memory_order_release);
+		return STATE_RUNNING;
+	}
+}
+
+namespace godot {
+
+// Everything is enabled until the project settings are read.
+#define LOG_CATEGORY_MASK(id, name) { LOG_MASK_ALL },
+
+std::atomic<uint32_t> log_masks[LOG_CATEGORY_MAX] = {
+	LOG_CATEGORIES(LOG_CATEGORY_MASK)
+};
+
+void log_set_mask(LogCategory category, uint32_t mask) {
+	log_masks[category].store(mask & LOG_MASK_ALL, std::memory_order_relaxed);
+}
+
+void log_write(LogLevel level, const char* category, const char* funcname, const char* format, va_list args) {
+	int64_t timestamp = now();
+	if (!check_rate_limit(category, timestamp))
+		return;
+
+	if (ensure_started() == STATE_STOPPED) {
+		std::lock_guard<std::mutex> guard(flush_mutex);
+		if (!push(level, category, funcname, timestamp, format, args))
+			dropped.fetch_add(1, std::memory_order_relaxed);
+		flush_entries();
+		return;
+	}
+
+	if (!push(level, category, funcname, timestamp, format, args)) {
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		wake.notify_one();
+		return;
+	}
+
+	// Don't wake the flush thread for every message. It's a syscall.
+	if (level == LOG_LEVEL_ERROR || enqueue_pos.load(std::memory_order_relaxed) - dequeue_pos.load(std::memory_order_relaxed) >= LOG_WAKE_THRESHOLD)
+		wake.notify_one();
+}
+
+void log_shutdown() {
+	std::lock_guard<std::mutex> guard(state_mutex);
+
+	int current_state = state.load(std::memory_order_relaxed);
+	if (current_state == STATE_IDLE)
+		init_clock_origins();
+
+	if (current_state == STATE_RUNNING) {
+		{
+			std::lock_guard<std::mutex> wake_guard(wake_mutex);
+			stop_requested = true;
+		}
+
+		wake.notify_one();
+		flush_thread.join();
+	}
+
+	state.store(STATE_STOPPED, std::memory_order_release);
+
+	std::lock_guard<std::mutex> flush_guard(flush_mutex);
+	flush_entries();
+}
+
+}
@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  logger.hpp                                                            */
+/*  Asynchronous logger that keeps formatting and I/O off hot paths.      */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+
+namespace godot {
+
+enum LogLevel {
+	LOG_LEVEL_ERROR,
+	LOG_LEVEL_WARNING,
+	LOG_LEVEL_MESSAGE,
+	LOG_LEVEL_DEBUG
+};
+
+// Every PRINT_CATEGORY must be listed here. print_* macros check this at
+// compile time. Categories can be enabled or disabled at runtime in
+// Project Settings > Acrylic Window > Logging.
+//
+// The enum, the names and the masks are all generated from this list,
+// so a new category can't be missing from any of them.
+#define LOG_CATEGORIES(X)								\
+	X(HELPERS, "helpers")								\
+	X(ACRYLIC_WINDOW, "AcrylicWindow")					\
+	X(SCROLLABLE_OPTION_BUTTON, "ScrollableOptionButton")	\
+	X(SWITCH_TWEEN, "SwitchTween")						\
+	X(ACRYLIC_THEME, "AcrylicTheme")					\
+	X(ACRYLIC_SETTINGS_PANEL, "AcrylicSettingsPanel")	\
+	X(ACRYLIC_BINDER, "AcrylicBinder")
+
+#define LOG_CATEGORY_ENUM(id, name) LOG_CATEGORY_##id,
+#define LOG_CATEGORY_NAME(id, name) name,
+
+enum LogCategory {
+	LOG_CATEGORIES(LOG_CATEGORY_ENUM)
+	LOG_CATEGORY_MAX
+};
+
+constexpr const char* LOG_CATEGORY_NAMES[LOG_CATEGORY_MAX] = {
+	LOG_CATEGORIES(LOG_CATEGORY_NAME)
+};
+
+constexpr uint32_t LOG_MASK_ALL = (1u << LOG_LEVEL_ERROR) | (1u << LOG_LEVEL_WARNING) | (1u << LOG_LEVEL_MESSAGE) | (1u << LOG_LEVEL_DEBUG);
+
+constexpr bool log_names_equal(const char* a, const char* b) {
+	while (*a && *a == *b) {
+		a++;
+		b++;
+	}
+
+	return *a == *b;
+}
+
+// Returns -1 if the category is unknown.
+constexpr int log_category_id(const char* name, int index = 0) {
+	return index == LOG_CATEGORY_MAX ? -1
+		: log_names_equal(name, LOG_CATEGORY_NAMES[index]) ? index
+		: log_category_id(name, index + 1);
+}
+
+// One bit per LogLevel.
+extern std::atomic<uint32_t> log_masks[LOG_CATEGORY_MAX];
+
+inline bool log_is_enabled(LogCategory category, LogLevel level) {
+	return (log_masks[category].load(std::memory_order_relaxed) & (1u << level)) != 0;
+}
+
+void log_set_mask(LogCategory category, uint32_t mask);
+
+// Formats the message on the calling thread and pushes it into a lock-free
+// ring buffer. The timestamp, colors and the actual write to stdout/stderr
+// are handled by a background flush thread.
+//
+// Messages are rate limited per category. If the ring buffer is full the
+// message is dropped and the number of dropped messages is reported later.
+void log_write(LogLevel level, const char* category, const char* funcname, const char* format, va_list args);
+
+// Writes all the pending messages and stops the flush thread.
+// Messages logged after this call are written synchronously.
+void log_shutdown();
+
+}
@@ -0,0 +1,302 @@
+/**************************************************************************/
+/*  monitors.cpp                                                          */
+/*  Custom Performance monitors for the extension internals.              */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "monitors.hpp"
+
+#include "helpers.hpp"
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/classes/tween.hpp>
+#include <godot_cpp/core/object.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+using namespace godot;
+
+namespace {
+	constexpr char PRINT_CATEGORY[] = "AcrylicWindow";
+
+	constexpr int64_t SAMPLE_INTERVAL = 1000000000; // ns
+
+	// Prune dead instance ids when there are too many of them
+	// even if nobody polls the monitors.
+	constexpr size_t PRUNE_THRESHOLD = 64;
+
+	// Quarter octave buckets. Values below 4 ns get their own buckets.
+	constexpr int HISTOGRAM_SIZE = 256;
+
+	std::atomic<uint64_t> hit_tests;
+	std::atomic<uint64_t> hit_test_time;
+	std::atomic<uint32_t> hit_test_histogram[HISTOGRAM_SIZE];
+	std::atomic<uint64_t> native_calls;
+	std::atomic<uint64_t> signals_emitted;
+	std::atomic<uint64_t> round_trips;
+	std::atomic<uint64_t> apply_style_round_trips;
+	std::atomic<uint64_t> frames_rendered;
+	std::atomic<uint64_t> frames_skipped;
+
+	// Instance ids of the objects created by the extension.
+	// Touched only on the main thread.
+	std::vector<uint64_t> tweens;
+	std::vector<uint64_t> nodes;
+
+	// The last complete sample. Monitors are polled on the main thread.
+	int64_t sample_time = 0;
+	double hit_tests_per_second = 0;
+	double hit_test_avg_usec = 0;
+	double hit_test_p99_usec = 0;
+	double native_calls_per_second = 0;
+
+	int get_bucket(uint64_t value) {
+		if (value < 4)
+			return static_cast<int>(value);
+
+		int msb = 0;
+		for (int shift = 32; shift; shift >>= 1) {
+			if (value >> (msb + shift))
+				msb += shift;
+		}
+
+		return (msb - 1) * 4 + static_cast<int>((value >> (msb - 2)) & 3);
+	}
+
+	uint64_t get_bucket_upper_bound(int bucket) {
+		if (bucket < 4)
+			return static_cast<uint64_t>(bucket);
+
+		int msb = bucket / 4 + 1;
+		uint64_t sub = static_cast<uint64_t>(bucket % 4);
+
+		return ((5 + sub) << (msb - 2)) - 1;
+	}
+
+	void update_sample() {
+		int64_t now = monitor_now();
+		int64_t elapsed = now - sample_time;
+		if (elapsed < SAMPLE_INTERVAL)
+			return;
+
+		bool first_sample = sample_time == 0;
+		sample_time = now;
+
+		uint64_t hit_test_count = hit_tests.exchange(0, std::memory_order_relaxed);
+		uint64_t hit_test_total = hit_test_time.exchange(0, std::memory_order_relaxed);
+		uint64_t native_call_count = native_calls.exchange(0, std::memory_order_relaxed);
+
+		uint32_t histogram[HISTOGRAM_SIZE];
+		uint64_t histogram_count = 0;
+		for (int i = 0; i < HISTOGRAM_SIZE; i++) {
+			histogram[i] = hit_test_histogram[i].exchange(0, std::memory_order_relaxed);
+			histogram_count += histogram[i];
+		}
+
+		// The counters have been accumulating since the library was loaded.
+		if (first_sample)
+			return;
+
+		double seconds = elapsed / 1e9;
+		hit_tests_per_second = hit_test_count / seconds;
+		native_calls_per_second = native_call_count / seconds;
+		hit_test_avg_usec = hit_test_count ? hit_test_total / 1e3 / hit_test_count : 0;
+
+		hit_test_p99_usec = 0;
+		uint64_t p99_rank = histogram_count - histogram_count / 100;
+		uint64_t rank = 0;
+		for (int i = 0; i < HISTOGRAM_SIZE && histogram_count; i++) {
+			rank += histogram[i];
+			if (rank >= p99_rank) {
+				hit_test_p99_usec = get_bucket_upper_bound(i) / 1e3;
+				break;
+			}
+		}
+	}
+
+	template <typename T>
+	int64_t count_alive(std::vector<uint64_t>& ids, bool (*is_active)(T*)) {
+		int64_t count = 0;
+		for (size_t i = 0; i < ids.size();) {
+			T* object = Object::cast_to<T>(ObjectDB::get_instance(ids[i]));
+			if (!object || !is_active(object)) {
+				ids[i] = ids.back();
+				ids.pop_back();
+				continue;
+			}
+
+			count++;
+			i++;
+		}
+
+		return count;
+	}
+
+	bool is_tween_active(Tween* tween) {
+		return tween->is_valid();
+	}
+
+	bool is_node_alive(Node* node) {
+		return true;
+	}
+
+	double get_hit_tests_per_second() {
+		update_sample();
+		return hit_tests_per_second;
+	}
+
+	double get_hit_test_avg_usec() {
+		update_sample();
+		return hit_test_avg_usec;
+	}
+
+	double get_hit_test_p99_usec() {
+		update_sample();
+		return hit_test_p99_usec;
+	}
+
+	double get_native_calls_per_second() {
+		update_sample();
+		return native_calls_per_second;
+	}
+
+	double get_signals_emitted() {
+		return static_cast<double>(signals_emitted.load(std::memory_order_relaxed));
+	}
+
+	double get_round_trips() {
+		return static_cast<double>(round_trips.load(std::memory_order_relaxed));
+	}
+
+	double get_apply_style_round_trips() {
+		return static_cast<double>(apply_style_round_trips.load(std::memory_order_relaxed));
+	}
+
+	double get_frames_rendered() {
+		return static_cast<double>(frames_rendered.load(std::memory_order_relaxed));
+	}
+
+	double get_frames_skipped() {
+		return static_cast<double>(frames_skipped.load(std::memory_order_relaxed));
+	}
+
+	double get_active_tweens() {
+		return static_cast<double>(count_alive<Tween>(tweens, &is_tween_active));
+	}
+
+	double get_nodes_created() {
+		return static_cast<double>(count_alive<Node>(nodes, &is_node_alive));
+	}
+
+	struct Monitor {
+		const char* id;
+		double (*get)();
+	};
+
+	const Monitor MONITORS[] = {
+		{ "AcrylicWindow/hit_tests_per_second", &get_hit_tests_per_second },
+		{ "AcrylicWindow/hit_test_avg_usec", &get_hit_test_avg_usec },
+		{ "AcrylicWindow/hit_test_p99_usec", &get_hit_test_p99_usec },
+		{ "AcrylicWindow/native_calls_per_second", &get_native_calls_per_second },
+		{ "AcrylicWindow/signals_emitted", &get_signals_emitted },
+		{ "AcrylicWindow/active_tweens", &get_active_tweens },
+		{ "AcrylicWindow/nodes_created", &get_nodes_created },
+		{ "AcrylicWindow/round_trips", &get_round_trips },
+		{ "AcrylicWindow/apply_style_round_trips", &get_apply_style_round_trips },
+		{ "AcrylicWindow/frames_rendered", &get_frames_rendered },
+		{ "AcrylicWindow/frames_skipped", &get_frames_skipped }
+	};
+}
+
+namespace godot {
+
+int64_t monitor_now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void monitor_hit_test(int64_t duration) {
+	uint64_t value = duration > 0 ? static_cast<uint64_t>(duration) : 0;
+	hit_tests.fetch_add(1, std::memory_order_relaxed);
+	hit_test_time.fetch_add(value, std::memory_order_relaxed);
+	hit_test_histogram[get_bucket(value)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void monitor_native_call() {
+	native_calls.fetch_add(1, std::memory_order_relaxed);
+}
+
+void monitor_signal_emitted() {
+	signals_emitted.fetch_add(1, std::memory_order_relaxed);
+}
+
+void monitor_round_trip() {
+	round_trips.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t monitor_get_round_trips() {
+	return round_trips.load(std::memory_order_relaxed);
+}
+
+void monitor_apply_style(uint64_t p_round_trips) {
+	apply_style_round_trips.store(p_round_trips, std::memory_order_relaxed);
+}
+
+void monitor_frame(bool rendered) {
+	(rendered ? frames_rendered : frames_skipped).fetch_add(1, std::memory_order_relaxed);
+}
+
+void monitor_tween(Tween* tween) {
+	if (!tween)
+		return;
+
+	if (tweens.size() >= PRUNE_THRESHOLD)
+		count_alive<Tween>(tweens, &is_tween_active);
+
+	tweens.push_back(tween->get_instance_id());
+}
+
+void monitor_node(Node* node) {
+	if (!node)
+		return;
+
+	if (nodes.size() >= PRUNE_THRESHOLD)
+		count_alive<Node>(nodes, &is_node_alive);
+
+	nodes.push_back(node->get_instance_id());
+}
+
+void register_monitors() {
+	Performance* performance = Performance::get_singleton();
+	if (!performance) {
+		print_error("Failed to get performance.");
+		return;
+	}
+
+	for (const Monitor& monitor : MONITORS) {
+		if (!performance->has_custom_monitor(monitor.id))
+			performance->add_custom_monitor(monitor.id, callable_mp_static(monitor.get));
+	}
+}
+
+void unregister_monitors() {
+	Performance* performance = Performance::get_singleton();
+	if (!performance)
+		return;
+
+	for (const Monitor& monitor : MONITORS) {
+		if (performance->has_custom_monitor(monitor.id))
+			performance->remove_custom_monitor(monitor.id);
+	}
+}
+
+}
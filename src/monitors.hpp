@@ -0,0 +1,93 @@
+/**************************************************************************/
+/*  monitors.hpp                                                          */
+/*  Custom Performance monitors for the extension internals.              */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+// Monitors show up in Debugger > Monitors > AcrylicWindow and can be queried
+// at runtime with Performance.get_custom_monitor("AcrylicWindow/<name>"):
+//
+//   hit_tests_per_second
+//   hit_test_avg_usec
+//   hit_test_p99_usec
+//   native_calls_per_second
+//   signals_emitted
+//   active_tweens
+//   nodes_created
+//   round_trips
+//   apply_style_round_trips
+//   frames_rendered
+//   frames_skipped
+
+namespace godot {
+
+class Node;
+class Tween;
+
+int64_t monitor_now();
+
+void monitor_hit_test(int64_t duration);
+void monitor_native_call();
+void monitor_signal_emitted();
+
+// Requests that wait for a reply of the display server (e.g. XInternAtoms).
+void monitor_round_trip();
+uint64_t monitor_get_round_trips();
+// Round trips made by the last apply_style.
+void monitor_apply_style(uint64_t round_trips);
+
+// Iterations drawn and skipped by on_demand_rendering.
+void monitor_frame(bool rendered);
+
+// Remember objects created by the extension to count the alive ones.
+void monitor_tween(Tween* tween);
+void monitor_node(Node* node);
+
+void register_monitors();
+void unregister_monitors();
+
+class HitTestMonitorScope {
+public:
+	HitTestMonitorScope()
+		: start(monitor_now())
+	{}
+
+	~HitTestMonitorScope() {
+		monitor_hit_test(monitor_now() - start);
+	}
+
+	HitTestMonitorScope(const HitTestMonitorScope&) = delete;
+	HitTestMonitorScope& operator=(const HitTestMonitorScope&) = delete;
+
+private:
+	int64_t start;
+};
+
+class ApplyStyleMonitorScope {
+public:
+	ApplyStyleMonitorScope()
+		: start(monitor_get_round_trips())
+	{}
+
+	~ApplyStyleMonitorScope() {
+		monitor_apply_style(monitor_get_round_trips() - start);
+	}
+
+	ApplyStyleMonitorScope(const ApplyStyleMonitorScope&) = delete;
+	ApplyStyleMonitorScope& operator=(const ApplyStyleMonitorScope&) = delete;
+
+private:
+	uint64_t start;
+};
+
+}
@@ -14,6 +14,8 @@
 
 #if defined(_WIN32) || defined(_WIN64)
 #include "native_window_windows.hpp"
+#elif defined(__linux__) && defined(ACRYLIC_X11)
+#include "native_window_x11.hpp"
 #else
 #include "native_window_base.hpp"
 namespace godot {
@@ -13,13 +13,17 @@
 #include "native_window_base.hpp"
 
 #include "helpers.hpp"
+#include "startup.hpp"
+#include "trace.hpp"
 
+#include <godot_cpp/classes/display_server.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/classes/rendering_server.hpp>
 #include <godot_cpp/classes/window.hpp>
 #include <godot_cpp/classes/scene_tree.hpp>
 
 namespace {
-	const char PRINT_CATEGORY[] = "AcrylicWindow";
+	constexpr char PRINT_CATEGORY[] = "AcrylicWindow";
 }
 
 namespace godot {
@@ -34,16 +38,70 @@ NativeWindowBase::NativeWindowBase(AcrylicWindow* acrylic_window)
 	}
 }
 
+bool NativeWindowBase::apply_startup_style(int32_t window_id, const StartupStyle& style) {
+	TRACE_SCOPE("NativeWindowBase::apply_startup_style");
+
+	DisplayServer* display_server = DisplayServer::get_singleton();
+	if (!display_server) {
+		print_error("Failed to get display server.");
+		return false;
+	}
+
+	RenderingServer* rendering_server = RenderingServer::get_singleton();
+	if (!rendering_server) {
+		print_error("Failed to get rendering server.");
+		return false;
+	}
+
+	ProjectSettings* project_settings = ProjectSettings::get_singleton();
+	if (!project_settings) {
+		print_error("Failed to get project settings.");
+		return false;
+	}
+
+	// The root viewport doesn't exist yet. It reads this setting when the scene tree is created.
+	project_settings->set_setting("rendering/viewport/transparent_background", style.backdrop != AcrylicWindow::BACKDROP_SOLID);
+
+	monitor_native_call();
+	display_server->window_set_flag(DisplayServer::WINDOW_FLAG_ALWAYS_ON_TOP, style.always_on_top, window_id);
+
+	monitor_native_call();
+	rendering_server->set_default_clear_color(style.clear_color);
+
+	return true;
+}
+
+bool NativeWindowBase::start_message_recording(const char* path) {
+	print_error("Message recording is not supported on this platform.");
+	return false;
+}
+
+bool NativeWindowBase::stop_message_recording() {
+	print_error("Message recording is not supported on this platform.");
+	return false;
+}
+
 bool NativeWindowBase::is_valid() const {
 	return window != nullptr;
 }
 
+bool NativeWindowBase::is_main_window() const {
+	SceneTree* scene_tree = window->get_tree();
+	return scene_tree && scene_tree->get_root() == window;
+}
+
 void NativeWindowBase::on_ready()
 {}
 
 void NativeWindowBase::on_exit_tree()
 {}
 
+void NativeWindowBase::on_mode_changed()
+{}
+
+void NativeWindowBase::on_focus_in()
+{}
+
 bool NativeWindowBase::minimize() {
 	window->set_mode(Window::MODE_MINIMIZED);
 	return true;
@@ -54,8 +112,14 @@ bool NativeWindowBase::maximize(bool toggle) {
 	return true;
 }
 
-// TODO Need to check if this code closes jsut this window or the whole application.
 bool NativeWindowBase::close() {
+	// Let the owner of a sub-window decide whether to hide or free it
+	// the same way as when the close button is pressed.
+	if (!is_main_window()) {
+		window->emit_signal("close_requested");
+		return true;
+	}
+
 	SceneTree* scene_tree = window->get_tree();
 	if (!scene_tree) {
 		print_error("Failed to get scene tree.");
@@ -68,28 +132,43 @@ bool NativeWindowBase::close() {
 }
 
 bool NativeWindowBase::set_text_size(const float p_text_size) {
+	TRACE_SCOPE("NativeWindowBase::set_text_size");
+
+	monitor_native_call();
 	window->set_content_scale_factor(p_text_size);
 	return true;
 }
 
 bool NativeWindowBase::set_always_on_top(const bool p_always_on_top) {
+	TRACE_SCOPE("NativeWindowBase::set_always_on_top");
+
+	monitor_native_call();
 	window->set_flag(Window::FLAG_ALWAYS_ON_TOP, p_always_on_top);
 	return true;
 }
 
 bool NativeWindowBase::set_drag_by_content(const bool p_drag_by_content) {
+	TRACE_SCOPE("NativeWindowBase::set_drag_by_content");
+
 	return true;
 }
 
 bool NativeWindowBase::set_drag_by_right_click(const bool p_drag_by_right_click) {
+	TRACE_SCOPE("NativeWindowBase::set_drag_by_right_click");
+
 	return true;
 }
 
 bool NativeWindowBase::set_frame(const AcrylicWindow::Frame p_frame) {
+	TRACE_SCOPE("NativeWindowBase::set_frame");
+
 	return true;
 }
 
 bool NativeWindowBase::set_backdrop(const AcrylicWindow::Backdrop p_backdrop) {
+	TRACE_SCOPE("NativeWindowBase::set_backdrop");
+
+	monitor_native_call();
 	window->set_transparent_background(p_backdrop != AcrylicWindow::BACKDROP_SOLID);
 	// need to redraw if changed transparency
 	acrylic_window->queue_redraw();
@@ -97,47 +176,107 @@ bool NativeWindowBase::set_backdrop(const AcrylicWindow::Backdrop p_backdrop) {
 }
 
 bool NativeWindowBase::set_corner(const AcrylicWindow::Corner p_corner) {
+	TRACE_SCOPE("NativeWindowBase::set_corner");
+
 	return true;
 }
 
 bool NativeWindowBase::set_autohide_title_bar(const AcrylicWindow::Autohide p_autohide_title_bar) {
+	TRACE_SCOPE("NativeWindowBase::set_autohide_title_bar");
+
 	return true;
 }
 
 bool NativeWindowBase::set_accent_title_bar(const AcrylicWindow::Accent p_accent_title_bar) {
+	TRACE_SCOPE("NativeWindowBase::set_accent_title_bar");
+
 	return true;
 }
 
 bool NativeWindowBase::set_auto_colors(const bool p_auto_colors) {
+	TRACE_SCOPE("NativeWindowBase::set_auto_colors");
+
 	return true;
 }
 
 bool NativeWindowBase::set_base_color(const Color& p_base_color) {
+	TRACE_SCOPE("NativeWindowBase::set_base_color");
+
 	return true;
 }
 
 bool NativeWindowBase::set_border_color(const Color& p_border_color) {
+	TRACE_SCOPE("NativeWindowBase::set_border_color");
+
 	return true;
 }
 
 bool NativeWindowBase::set_title_bar_color(const Color& p_title_bar_color) {
+	TRACE_SCOPE("NativeWindowBase::set_title_bar_color");
+
 	return true;
 }
 
 bool NativeWindowBase::set_text_color(const Color& p_text_color) {
+	TRACE_SCOPE("NativeWindowBase::set_text_color");
+
 	return true;
 }
 
 bool NativeWindowBase::set_clear_color(const Color& p_clear_color) {
+	TRACE_SCOPE("NativeWindowBase::set_clear_color");
+
+	// The default clear color is global. Sub-windows are covered by
+	// the background of their AcrylicWindow anyway.
+	if (!is_main_window())
+		return true;
+
 	auto rendering_server = RenderingServer::get_singleton();
 	if (!rendering_server) {
 		print_error("Failed to get rendering server.");
 		return false;
 	}
 
+	monitor_native_call();
 	rendering_server->set_default_clear_color(p_clear_color);
 
 	return true;
 }
 
-} // namespace godot
\ No newline at end of file
+bool NativeWindowBase::has_regions() const {
+	return false;
+}
+
+bool NativeWindowBase::set_regions(const std::vector<acrylic::Rect>& opaque_region, bool blur, const std::vector<acrylic::Rect>& blur_region) {
+	return true;
+}
+
+bool NativeWindowBase::has_hit_test() const {
+	return false;
+}
+
+bool NativeWindowBase::set_mouse_passthrough(const std::vector<acrylic::Point>& polygon) {
+	TRACE_SCOPE("NativeWindowBase::set_mouse_passthrough");
+
+	// Embedded windows don't have a native window to pass the mouse through.
+	if (window->is_embedded())
+		return true;
+
+	DisplayServer* display_server = DisplayServer::get_singleton();
+	if (!display_server) {
+		print_error("Failed to get display server.");
+		return false;
+	}
+
+	PackedVector2Array region;
+	region.resize(static_cast<int64_t>(polygon.size()));
+	for (size_t i = 0; i < polygon.size(); i++)
+		region.set(static_cast<int64_t>(i), Vector2(polygon[i].x, polygon[i].y));
+
+	monitor_native_call();
+	display_server->window_set_mouse_passthrough(region, window->get_window_id());
+
+	return true;
+}
+
+} // namespace godot
@@ -13,21 +13,40 @@
 #pragma once
 
 #include "acrylic_window.hpp"
+#include "core/geometry.hpp"
+
+#include <vector>
 
 namespace godot {
 
 class Window;
+struct StartupStyle;
 
 class NativeWindowBase {
 public:
 	NativeWindowBase(AcrylicWindow* acrylic_window);
 
+public:
+	// Styles a window before any AcrylicWindow is attached to it.
+	static bool apply_startup_style(int32_t window_id, const StartupStyle& style);
+
+	// Records the messages of all the native windows for message-replay.
+	// Only the platforms with a native window procedure support it.
+	static bool start_message_recording(const char* path);
+	static bool stop_message_recording();
+
 public:
 	bool is_valid() const;
 
+	// The root window of the scene tree. The other windows are sub-windows.
+	bool is_main_window() const;
+
 public:
 	void on_ready();
 	void on_exit_tree();
+	// Godot may rewrite native window state on these, so cached state is stale.
+	void on_mode_changed();
+	void on_focus_in();
 
 public:
 	bool minimize();
@@ -51,6 +70,19 @@ public:
 	bool set_text_color(const Color& p_text_color);
 	bool set_clear_color(const Color& p_clear_color);
 
+public:
+	// Whether the compositor takes opaque and blur regions from the window.
+	// Regions are in window pixels.
+	bool has_regions() const;
+	bool set_regions(const std::vector<acrylic::Rect>& opaque_region, bool blur, const std::vector<acrylic::Rect>& blur_region);
+
+	// Only the area inside the polygon (even-odd rule, window pixels) gets
+	// the mouse, the rest goes to the windows below. Empty turns it off.
+	bool set_mouse_passthrough(const std::vector<acrylic::Point>& polygon);
+
+	// Whether native hit tests read the snapshot of AcrylicWindow.
+	bool has_hit_test() const;
+
 protected:
 	AcrylicWindow* acrylic_window = nullptr;
 	Window* window = nullptr;
@@ -14,55 +14,93 @@
 
 #if defined(_WIN32) || defined(_WIN64)
 
+#include "core/border.hpp"
+#include "core/hit_test.hpp"
+#include "core/message.hpp"
+#include "core/message_log.hpp"
+#include "core/style.hpp"
+#include "core/window_registry.hpp"
+#include "screen_scales.hpp"
+#include "startup.hpp"
+#include "trace.hpp"
+
 #include <godot_cpp/classes/color_rect.hpp>
 #include <godot_cpp/classes/display_server.hpp>
 #include <godot_cpp/classes/tween.hpp>
 #include <godot_cpp/classes/window.hpp>
 #include <godot_cpp/classes/rendering_server.hpp>
 
-#include <map>
+#include <atomic>
+#include <climits>
 #include <mutex>
 
 #define WIN32_LEAN_AND_MEAN
 
 #include <dwmapi.h>
 #include <Windows.h>
-#include <windowsx.h>
 
 #pragma comment(lib, "Dwmapi.lib")
 
-#define DEBUG_DWM FALSE
+// Embedded windows are drawn into the native window of their embedder.
+// They don't have a native window of their own, so only the Godot side applies.
+#define EMBEDDED_GUARD(super_call)	\
+	if (hwnd == NULL)				\
+		return super_call;
 
 using namespace godot;
 
 namespace {
-	const char PRINT_CATEGORY[] = "AcrylicWindow";
+	constexpr char PRINT_CATEGORY[] = "AcrylicWindow";
 
+	// Everything wndproc needs to know about a subclassed window.
 	struct thunk_s {
 		AcrylicWindow* window;
 		WNDPROC godot_wndproc;
+		acrylic::MessageState state;
+		acrylic::BorderMetricsCache border_metrics;
+		// Inside the modal move/size loop of the system.
+		bool in_size_move = false;
 	};
 
+	// Messages are dispatched on the thread that created the window,
+	// the mutex guards against windows created on other threads.
 	std::mutex mutex;
-	std::map<HWND, thunk_s> windows;
+	acrylic::WindowRegistry<thunk_s> windows;
 
-	bool right_click_down = false;
-	HWND right_click_hwnd = NULL;
-	bool right_click_can_drag = false;
-	POINT right_click_pos = {};
-	POINT right_click_move = {};
+	// Messages of all the windows while start_message_recording is running.
+	std::mutex recorder_mutex;
+	acrylic::MessageRecorder recorder;
+	std::atomic<bool> recording;
 
-#if DEBUG_DWM
-	long dy = 0;
-#endif
+	uint64_t get_window_key(HWND hwnd) {
+		return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(hwnd));
+	}
 
-	HWND get_native_handle(Window* window) {
-		if (!window) {
-			print_error("Window is null.");
-			return NULL;
-		}
+	static_assert(int(acrylic::FRAME_CUSTOM) == int(AcrylicWindow::FRAME_CUSTOM)
+		&& int(acrylic::BACKDROP_TABBED) == int(AcrylicWindow::BACKDROP_TABBED)
+		&& int(acrylic::CORNER_ROUND_SMALL) == int(AcrylicWindow::CORNER_ROUND_SMALL),
+		"acrylic enums are out of sync with AcrylicWindow.");
+	static_assert(DWMSBT_AUTO == 0 && DWMSBT_NONE == 1 && DWMSBT_MAINWINDOW == 2 && DWMSBT_TRANSIENTWINDOW == 3 && DWMSBT_TABBEDWINDOW == 4,
+		"acrylic::get_dwm_backdrop_type is out of sync with DWM_SYSTEMBACKDROP_TYPE.");
+	static_assert(DWMWCP_DEFAULT == 0 && DWMWCP_DONOTROUND == 1 && DWMWCP_ROUND == 2 && DWMWCP_ROUNDSMALL == 3,
+		"acrylic::get_dwm_corner_preference is out of sync with DWM_WINDOW_CORNER_PREFERENCE.");
+	static_assert(acrylic::MESSAGE_NCCALCSIZE == WM_NCCALCSIZE && acrylic::MESSAGE_NCHITTEST == WM_NCHITTEST && acrylic::MESSAGE_NCACTIVATE == WM_NCACTIVATE
+		&& acrylic::MESSAGE_NCRBUTTONDOWN == WM_NCRBUTTONDOWN && acrylic::MESSAGE_NCRBUTTONUP == WM_NCRBUTTONUP
+		&& acrylic::MESSAGE_KEYUP == WM_KEYUP && acrylic::MESSAGE_SYSKEYUP == WM_SYSKEYUP
+		&& acrylic::MESSAGE_RBUTTONDOWN == WM_RBUTTONDOWN && acrylic::MESSAGE_RBUTTONUP == WM_RBUTTONUP,
+		"acrylic::MessageId is out of sync with WM_*.");
+	static_assert(acrylic::HIT_TEST_CLIENT == HTCLIENT && acrylic::HIT_TEST_CAPTION == HTCAPTION && acrylic::HIT_TEST_TOP == HTTOP,
+		"acrylic hit test results are out of sync with HT*.");
+
+	acrylic::Rect to_rect(const RECT& rect) {
+		return { rect.left, rect.top, rect.right, rect.bottom };
+	}
+
+	RECT to_native_rect(const acrylic::Rect& rect) {
+		return { rect.left, rect.top, rect.right, rect.bottom };
+	}
 
-		int32_t window_id = window->get_window_id();
+	HWND get_native_handle(int32_t window_id) {
 		if (window_id == DisplayServer::INVALID_WINDOW_ID) {
 			print_error("Invalid window id.");
 			return NULL;
@@ -79,252 +117,190 @@ namespace {
 		return reinterpret_cast<HWND>(native_handle);
 	}
 
-	bool get_window_border(HWND hwnd, RECT* border) {
-		WINDOWPLACEMENT placement = {};
-		placement.length = sizeof(WINDOWPLACEMENT);
-		if (!GetWindowPlacement(hwnd, &placement)) {
-			print_debug("Failed to GetWindowPlacement. Error: %d.", GetLastError());
-			return false;
+	HWND get_native_handle(Window* window) {
+		if (!window) {
+			print_error("Window is null.");
+			return NULL;
 		}
 
-		LONG_PTR style = GetWindowLongPtr(hwnd, GWL_STYLE);
-		if (!style) {
-			print_debug("Failed to GetWindowLongPtr(GWL_STYLE). Error: %d.", GetLastError());
-			return false;
-		}
+		return get_native_handle(window->get_window_id());
+	}
 
-		RECT rect = {};
-		if (!AdjustWindowRectEx(&rect, style & ~WS_CAPTION, FALSE, 0)) {
-			print_debug("Failed to GetWindowPlacement. Error: %d.", GetLastError());
-			return false;
+	// Queries the frame rects only after the cache has been invalidated by wndproc.
+	bool get_frame_rects(acrylic::BorderMetricsCache& cache, HWND hwnd, acrylic::MessageGeometry* geometry) {
+		if (!cache.is_valid()) {
+			LONG_PTR style = GetWindowLongPtr(hwnd, GWL_STYLE);
+			if (!style) {
+				print_debug("Failed to GetWindowLongPtr(GWL_STYLE). Error: %d.", GetLastError());
+				return false;
+			}
+
+			RECT frame_rect = {};
+			if (!AdjustWindowRectEx(&frame_rect, style & ~WS_CAPTION, FALSE, 0)) {
+				print_debug("Failed to AdjustWindowRectEx. Error: %d.", GetLastError());
+				return false;
+			}
+
+			RECT caption_rect = {};
+			if (!AdjustWindowRectEx(&caption_rect, style | WS_CAPTION, FALSE, 0)) {
+				print_debug("Failed to AdjustWindowRectEx. Error: %d.", GetLastError());
+				// Nothing is draggable.
+				caption_rect.top = INT_MAX;
+			}
+
+			cache.store(to_rect(frame_rect), to_rect(caption_rect));
 		}
 
-		// Divide top by 5 because Windows returns -10
-		// though -2 is enough to hide thick border at the top.
-		border->top = placement.showCmd == SW_SHOWMAXIMIZED ? rect.top : (rect.top / 5);
-		border->left = rect.left;
-		border->right = rect.right;
-		border->bottom = rect.bottom;
+		geometry->has_frame_rects = true;
+		geometry->frame_rect = cache.get_frame_rect();
+		geometry->caption_rect = cache.get_caption_rect();
+		geometry->maximized = IsZoomed(hwnd) != FALSE;
 
 		return true;
 	}
 
-	void on_right_click_down(HWND hwnd, WPARAM wParam, LPARAM lParam, bool screen_space) {
-		POINT click_pos = {
-			GET_X_LPARAM(lParam),
-			GET_Y_LPARAM(lParam)
-		};
+	// Queries only the native state that acrylic::handle_message reads for the message.
+	// Returns false if the message must go on to Godot untouched.
+	bool get_message_geometry(thunk_s* thunk, HWND hwnd, const acrylic::Message& message, acrylic::MessageGeometry* geometry) {
+		switch (message.id) {
+		case WM_NCHITTEST: {
+			geometry->default_hit_test = static_cast<int32_t>(DefWindowProc(hwnd, WM_NCHITTEST,
+				static_cast<WPARAM>(message.wparam), static_cast<LPARAM>(message.lparam)));
+			if (geometry->default_hit_test != HTCLIENT)
+				return true;
 
-		if (!screen_space) {
-			if (!ClientToScreen(hwnd, &click_pos)) {
-				print_error("Failed to ClientToScreen. Error: %d.", GetLastError());
-				return;
+			POINT client_origin = {};
+			if (!ClientToScreen(hwnd, &client_origin)) {
+				print_debug("Failed to ClientToScreen. Error: %d.", GetLastError());
+				return false;
 			}
-		}
 
-		right_click_down = true;
-		right_click_hwnd = hwnd;
-		right_click_can_drag = false;
-		right_click_pos = click_pos;
-		right_click_move = {};
-	}
+			geometry->client_origin = { client_origin.x, client_origin.y };
 
-	void on_right_click_up(HWND hwnd) {
-		if (right_click_hwnd != hwnd)
-			return;
+			if (!get_frame_rects(thunk->border_metrics, hwnd, geometry))
+				print_debug("Failed to get window border (WM_NCHITTEST). Using default border.");
 
-		right_click_down = false;
-		right_click_hwnd = NULL;
-		right_click_can_drag = false;
-	}
+			if (thunk->state.right_click_drag.is_pressed()) {
+				// Use magical numbers because Godot overrides key constants on Windows.
+				geometry->right_button_down = (GetAsyncKeyState(0x02) & (1 << 15)) != 0;
 
-	bool on_syskey_up(WPARAM wParam, LPARAM lParam, AcrylicWindow* window) {
-		// Use magical numbers because Godot overrides key constants on Windows.
-		if (wParam == 0x0D) { // ENTER
-			if ((lParam & (1 << 24)) || (lParam & (1 << 29))) { // ALT
-				window->maximize();
-				return true;
+				RECT window_rect = {};
+				geometry->has_window_rect = GetWindowRect(hwnd, &window_rect) != FALSE;
+				if (!geometry->has_window_rect)
+					print_debug("Failed to GetWindowRect. Error: %d.", GetLastError());
+
+				geometry->window_rect = to_rect(window_rect);
 			}
-		}
+		} break;
 
-		return false;
-	}
+		case WM_NCCALCSIZE:
+			if (!message.wparam)
+				return true;
 
-	bool on_key_up(HWND hwnd, WPARAM wParam, LPARAM lParam, AcrylicWindow* window) {
-		// Use magical numbers because Godot overrides key constants on Windows.
-		switch (wParam) {
-		case 0x7A: // F11
-			window->maximize();
-			return true;
+			geometry->proposed_client_rect = to_rect(reinterpret_cast<NCCALCSIZE_PARAMS*>(message.lparam)->rgrc[0]);
 
-#if 0//DEBUG_DWM
-		case 0x26: // Arrow Up
-			dy += 1;
-			SetWindowPos(hwnd, NULL, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_FRAMECHANGED);
+			if (thunk->window->get_frame() == AcrylicWindow::FRAME_CUSTOM && !get_frame_rects(thunk->border_metrics, hwnd, geometry))
+				print_debug("Failed to get window border (WM_NCCALCSIZE). Using default border.");
 			break;
 
-		case 0x28: // Arrow Down
-			dy -= 1;
-			SetWindowPos(hwnd, NULL, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_FRAMECHANGED);
-			break;
-#endif
-		}
+		case WM_RBUTTONDOWN: {
+			POINT client_origin = {};
+			if (!ClientToScreen(hwnd, &client_origin)) {
+				print_error("Failed to ClientToScreen. Error: %d.", GetLastError());
+				return false;
+			}
 
-		return false;
-	}
+			geometry->client_origin = { client_origin.x, client_origin.y };
+		} break;
+		}
 
-	bool on_ncactivate(WPARAM wParam, AcrylicWindow* window) {
-		window->dim(wParam == FALSE);
 		return true;
 	}
 
-	bool on_nccalcsize(AcrylicWindow::Frame frame, HWND hwnd, WPARAM wParam, LPARAM lParam) {
-		if (wParam == FALSE)
-			return false;
+	void apply_message_result(HWND hwnd, AcrylicWindow* window, const acrylic::MessageResult& result, LPARAM lParam) {
+		if (result.actions & acrylic::MESSAGE_ACTION_MAXIMIZE)
+			window->maximize();
 
-		if (frame == AcrylicWindow::FRAME_DEFAULT)
-			return false;
+		if (result.actions & (acrylic::MESSAGE_ACTION_DIM | acrylic::MESSAGE_ACTION_UNDIM))
+			window->dim((result.actions & acrylic::MESSAGE_ACTION_DIM) != 0);
 
-		if (frame == AcrylicWindow::FRAME_BORDERLESS) {
-			// remove a thin resize border at the top
-			NCCALCSIZE_PARAMS* sz = (NCCALCSIZE_PARAMS*)lParam;
-			sz->rgrc[0].top -= 2;
-			return true;
-		}
-		
-		RECT border = {};
-		if (!get_window_border(hwnd, &border)) {
-			print_debug("Failed to get window border (WM_NCCALCSIZE). Using default border.");
-			border = { 5, 5, 5, 5 };
+		if (result.actions & acrylic::MESSAGE_ACTION_MOVE) {
+			if (!SetWindowPos(hwnd, NULL, result.window_position.x, result.window_position.y, 0, 0, SWP_NOSIZE | SWP_NOZORDER))
+				print_debug("Failed to SetWindowPos. Error: %d.", GetLastError());
 		}
 
-		NCCALCSIZE_PARAMS* sz = (NCCALCSIZE_PARAMS*)lParam;
-
-		sz->rgrc[0].top -= border.top;
-		sz->rgrc[0].left -= border.left;
-		sz->rgrc[0].right -= border.right;
-		sz->rgrc[0].bottom -= border.bottom;
-
-#if DEBUG_DWM
-		print_debug("%d %d %d %d %d", dy, border.top, border.left, border.right, border.bottom);
-#endif
-
-		return true;
+		if (result.actions & acrylic::MESSAGE_ACTION_SET_CLIENT_RECT)
+			reinterpret_cast<NCCALCSIZE_PARAMS*>(lParam)->rgrc[0] = to_native_rect(result.client_rect);
 	}
 
-	LRESULT on_nchittest(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam, AcrylicWindow* window) {
-		LRESULT result = DefWindowProc(hwnd, uMsg, wParam, lParam);
-		if (result != HTCLIENT)
-			return result;
-
-		RECT border = {};
-		if (!get_window_border(hwnd, &border)) {
-			print_debug("Failed to get window border (WM_NCHITTEST). Using default border.");
-			border = { -10, 5, 5, 5 };
-		}
-
-		POINT screen_cursor = {
-			GET_X_LPARAM(lParam),
-			GET_Y_LPARAM(lParam)
-		};
-
-		POINT client_cursor = screen_cursor;
-		if (!ScreenToClient(hwnd, &client_cursor)) {
-			print_debug("Failed to ScreenToClient. Error: %d.", GetLastError());
-			return HTCLIENT;
-		}
+	// Returns true if the message must not go on to Godot.
+	bool handle_core_message(thunk_s* thunk, HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam, LRESULT* lresult) {
+		acrylic::Message message;
+		message.id = uMsg;
+		message.wparam = static_cast<uint64_t>(wParam);
+		message.lparam = static_cast<int64_t>(lParam);
 
-#if DEBUG_DWM
-		print_debug("%d %d %d", client_cursor.x, client_cursor.y, border.top);
-#endif
-
-		if (client_cursor.y < -border.top)
-			return HTTOP;
+		acrylic::MessageGeometry geometry;
+		if (!get_message_geometry(thunk, hwnd, message, &geometry))
+			return false;
 
-		if (right_click_down && right_click_hwnd == hwnd && window->get_drag_by_right_click()) {
-			if (!(GetAsyncKeyState(0x02) & (1 << 15))) {
-				on_right_click_up(hwnd);
-			}
-			else {
-				POINT delta = {
-					screen_cursor.x - right_click_pos.x,
-					screen_cursor.y - right_click_pos.y,
-				};
-
-				if (!right_click_can_drag) {
-					right_click_move.x += std::abs(delta.x);
-					right_click_move.y += std::abs(delta.y);
-
-					right_click_can_drag = right_click_move.x > 10 || right_click_move.y > 10;
-				}
-
-				right_click_pos.x = screen_cursor.x;
-				right_click_pos.y = screen_cursor.y;
-
-				if (right_click_can_drag) {
-					RECT rect = {};
-					if (!GetWindowRect(hwnd, &rect)) {
-						print_debug("Failed to GetWindowRect. Error: %d.", GetLastError());
-					}
-					else {
-						if (!SetWindowPos(hwnd, NULL, rect.left + delta.x, rect.top + delta.y, 0, 0, SWP_NOSIZE | SWP_NOZORDER))
-							print_debug("Failed to SetWindowPos. Error: %d.", GetLastError());
-						return HTCAPTION;
-					}
-				}
-			}
-		}
+		acrylic::Frame frame = static_cast<acrylic::Frame>(thunk->window->get_frame());
 
-		bool can_drag = window->get_drag_by_content();
-		if (!can_drag) {
-			border = {};
-			if (!AdjustWindowRectEx(&border, GetWindowLongPtr(hwnd, GWL_STYLE) | WS_CAPTION, FALSE, 0)) {
-				print_debug("Failed to AdjustWindowRectEx. Error: %d.", GetLastError());
-				can_drag = false;
-			}
-			else {
-				can_drag = client_cursor.y < -border.top;
-			}
-		}
+		// The snapshot published by AcrylicWindow instead of the scene tree.
+		// Nothing is draggable until the first one.
+		acrylic::MessageResult result;
+		thunk->window->get_hit_test_buffer().read([&](const acrylic::HitTestSnapshot& snapshot) {
+			result = acrylic::handle_message(thunk->state, frame, snapshot, geometry, message);
 
-		if (can_drag) {
-			Window* root_window = window->get_window();
-			if (!root_window) {
-				print_error("Failed to get root window.");
-				return HTCAPTION;
+			if (recording.load(std::memory_order_relaxed)) {
+				std::lock_guard<std::mutex> guard(recorder_mutex);
+				recorder.record(get_window_key(hwnd), frame, snapshot, geometry, message, result);
 			}
+		});
 
-			// Need this to close popups correctly.
-			if (has_popup(root_window))
-				return HTCLIENT;
+		apply_message_result(hwnd, thunk->window, result, lParam);
 
-			Control* blocking_control = find_mouse_blocking_control(root_window);
-			if (!blocking_control)
-				return HTCAPTION;
-			
-			// Need this to show Aero Snap Layouts.
-			// TODO glitchy
-			// if (blocking_control->has_meta("maximize_button"))
-			//	return HTMAXBUTTON;
+		*lresult = static_cast<LRESULT>(result.result);
+		return result.handled;
+	}
 
-			// print_debug("%s", blocking_control->get_name().c_escape().ascii().get_data());
+	// Span names of the messages handled by wndproc.
+	const char* get_message_trace_name(UINT uMsg) {
+		switch (uMsg) {
+		case WM_NCACTIVATE: return "WM_NCACTIVATE";
+		case WM_NCCALCSIZE: return "WM_NCCALCSIZE";
+		case WM_NCHITTEST: return "WM_NCHITTEST";
+		case WM_KEYUP: return "WM_KEYUP";
+		case WM_SYSKEYUP: return "WM_SYSKEYUP";
+		case WM_RBUTTONDOWN: return "WM_RBUTTONDOWN";
+		case WM_NCRBUTTONDOWN: return "WM_NCRBUTTONDOWN";
+		case WM_RBUTTONUP: return "WM_RBUTTONUP";
+		case WM_NCRBUTTONUP: return "WM_NCRBUTTONUP";
+		case WM_DISPLAYCHANGE: return "WM_DISPLAYCHANGE";
+		case WM_STYLECHANGED: return "WM_STYLECHANGED";
+		case WM_DPICHANGED: return "WM_DPICHANGED";
+		case WM_SETTINGCHANGE: return "WM_SETTINGCHANGE";
+		case WM_ENTERSIZEMOVE: return "WM_ENTERSIZEMOVE";
+		case WM_SIZING: return "WM_SIZING";
+		case WM_EXITSIZEMOVE: return "WM_EXITSIZEMOVE";
+		default: return "wndproc";
 		}
-
-		return HTCLIENT;
 	}
 
 	LRESULT CALLBACK wndproc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+		TRACE_SCOPE(get_message_trace_name(uMsg));
+
 		mutex.lock();
-		auto thunk = windows.find(hwnd);
+		thunk_s* thunk = windows.find(get_window_key(hwnd));
 		mutex.unlock();
 
-		if (thunk == windows.end()) {
+		if (!thunk) {
 			print_warning("Failed to find window by native handle.");
 			return DefWindowProc(hwnd, uMsg, wParam, lParam);
 		}
 
-		AcrylicWindow* window = thunk->second.window;
-		WNDPROC godot_wndproc = thunk->second.godot_wndproc;
+		AcrylicWindow* window = thunk->window;
+		WNDPROC godot_wndproc = thunk->godot_wndproc;
 
 		//if (window->get_frame() != AcrylicWindow::FRAME_CUSTOM)
 		//	return CallWindowProc(godot_wndproc, hwnd, uMsg, wParam, lParam);
@@ -333,43 +309,54 @@ namespace {
 		// otherwise it messes up window.
 
 		switch (uMsg) {
-		case WM_NCACTIVATE:
-			if (on_ncactivate(wParam, window))
-				return 0;
-			break;
-
-		case WM_NCCALCSIZE:
-			if (on_nccalcsize(window->get_frame(), hwnd, wParam, lParam))
-				return 0;
-			break;
-
 		case WM_NCHITTEST: {
-			LRESULT result = on_nchittest(hwnd, uMsg, wParam, lParam, window);
-			if (result != HTCLIENT)
+			TRACE_SCOPE("on_nchittest");
+			HitTestMonitorScope monitor_scope;
+
+			LRESULT result = 0;
+			if (handle_core_message(thunk, hwnd, uMsg, wParam, lParam, &result))
 				return result;
 		} break;
-		
+
+		case WM_NCACTIVATE:
+		case WM_NCCALCSIZE:
 		case WM_KEYUP:
-			if (on_key_up(hwnd, wParam, lParam, window))
-				return 0;
+		case WM_SYSKEYUP:
+		case WM_RBUTTONDOWN:
+		case WM_NCRBUTTONDOWN:
+		case WM_RBUTTONUP:
+		case WM_NCRBUTTONUP: {
+			LRESULT result = 0;
+			if (handle_core_message(thunk, hwnd, uMsg, wParam, lParam, &result))
+				return result;
+		} break;
+
+		case WM_DISPLAYCHANGE:
+			// Screens have been added, removed or rearranged.
+			invalidate_screen_scales();
 			break;
 
-		case WM_SYSKEYUP:
-			if (on_syskey_up(wParam, lParam, window))
-				return 0;
+		case WM_STYLECHANGED:
+		case WM_DPICHANGED:
+		case WM_SETTINGCHANGE:
+			// The frame rects depend on the style and the DPI. System metrics
+			// such as the border width can change with the settings.
+			thunk->border_metrics.invalidate();
 			break;
 
-		case WM_RBUTTONDOWN:
-			on_right_click_down(hwnd, wParam, lParam, false);
+		case WM_ENTERSIZEMOVE:
+			thunk->in_size_move = true;
 			break;
 
-		case WM_NCRBUTTONDOWN:
-			on_right_click_down(hwnd, wParam, lParam, true);
+		case WM_SIZING:
+			// The loop is entered for moving too, only WM_SIZING tells it's a resize.
+			if (thunk->in_size_move && !window->is_live_resizing())
+				window->begin_live_resize(true);
 			break;
 
-		case WM_RBUTTONUP:
-		case WM_NCRBUTTONUP:
-			on_right_click_up(hwnd);
+		case WM_EXITSIZEMOVE:
+			thunk->in_size_move = false;
+			window->end_live_resize();
 			break;
 		}
 
@@ -381,13 +368,18 @@ namespace {
 
 		std::lock_guard<std::mutex> guard(mutex);
 
+		if (windows.find(get_window_key(hwnd))) {
+			print_error("The window already has an AcrylicWindow. Only one AcrylicWindow per window is supported.");
+			return false;
+		}
+
 		auto godot_wndproc = (WNDPROC)SetWindowLongPtr(hwnd, GWLP_WNDPROC, (LONG_PTR)&wndproc);
 		if (!godot_wndproc) {
 			print_error("Failed to SetWindowLongPtr(GWLP_WNDPROC). Error: %d.", GetLastError());
 			return false;
 		}
 
-		windows.insert({ hwnd, { acrylic_window, godot_wndproc } });
+		windows.insert(get_window_key(hwnd), { acrylic_window, godot_wndproc, {} });
 
 		return true;
 	}
@@ -398,14 +390,14 @@ namespace {
 		WNDPROC godot_wndproc = nullptr; {
 			std::lock_guard<std::mutex> guard(mutex);
 
-			auto thunk = windows.find(hwnd);
-			if (thunk == windows.end()) {
+			thunk_s* thunk = windows.find(get_window_key(hwnd));
+			if (!thunk) {
 				print_error("Failed to find window by native handle.");
 				return false;
 			}
 
-			godot_wndproc = thunk->second.godot_wndproc;
-			windows.erase(hwnd);
+			godot_wndproc = thunk->godot_wndproc;
+			windows.erase(get_window_key(hwnd));
 		}
 
 		if (!SetWindowLongPtr(hwnd, GWLP_WNDPROC, (LONG_PTR)godot_wndproc)) {
@@ -418,6 +410,7 @@ namespace {
 
 	bool set_color(HWND hwnd, DWMWINDOWATTRIBUTE color_attribute, const Color& color) {
 		COLORREF new_color = color.to_abgr32() & 0x00ffffff; // remove alpha to make DwmSetWindowAttribute happy
+		monitor_native_call();
 		HRESULT hresult = DwmSetWindowAttribute(hwnd, color_attribute, &new_color, sizeof(new_color));
 		if (FAILED(hresult)) {
 			print_error("Failed to set color attribute = %d. Error: %d.", color_attribute, hresult);
@@ -426,6 +419,52 @@ namespace {
 
 		return true;
 	}
+
+	bool set_backdrop(HWND hwnd, AcrylicWindow::Backdrop backdrop) {
+		bool apply = false;
+
+		int new_backdrop = acrylic::get_dwm_backdrop_type(static_cast<acrylic::Backdrop>(backdrop));
+
+		int old_backdrop = DWMSBT_AUTO;
+		monitor_native_call();
+		HRESULT hresult = DwmGetWindowAttribute(hwnd, DWMWA_SYSTEMBACKDROP_TYPE, &old_backdrop, sizeof(old_backdrop));
+		if (FAILED(hresult)) {
+			print_error("Failed to get DWMWA_SYSTEMBACKDROP_TYPE. Error: %d.", hresult);
+			apply = true;
+		}
+		else {
+			apply = new_backdrop != old_backdrop;
+		}
+
+		if (!apply) {
+			print_debug("The new backdrop is the same as the old one. No changes made.");
+			return true;
+		}
+
+		print_debug("Setting the new backdrop %d. The current backdrop is %d.", new_backdrop, old_backdrop);
+
+		monitor_native_call();
+		hresult = DwmSetWindowAttribute(hwnd, DWMWA_SYSTEMBACKDROP_TYPE, &new_backdrop, sizeof(new_backdrop));
+		if (FAILED(hresult)) {
+			print_error("Failed to set DWMWA_SYSTEMBACKDROP_TYPE. Error: %d.", hresult);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool set_corner(HWND hwnd, AcrylicWindow::Corner corner) {
+		UINT value = static_cast<UINT>(acrylic::get_dwm_corner_preference(static_cast<acrylic::Corner>(corner)));
+
+		monitor_native_call();
+		HRESULT hresult = DwmSetWindowAttribute(hwnd, DWMWA_WINDOW_CORNER_PREFERENCE, &value, sizeof(value));
+		if (FAILED(hresult)) {
+			print_error("Failed to set corner = %d. Error: %d.", value, hresult);
+			return false;
+		}
+
+		return true;
+	}
 }
 
 namespace godot {
@@ -437,6 +476,10 @@ NativeWindow::NativeWindow(AcrylicWindow* acrylic_window)
 	if (!window)
 		return;
 
+	// See EMBEDDED_GUARD.
+	if (window->is_embedded())
+		return;
+
 	hwnd = ::get_native_handle(window);
 	if (hwnd == NULL) {
 		print_error("Failed to get native handle.");
@@ -444,21 +487,72 @@ NativeWindow::NativeWindow(AcrylicWindow* acrylic_window)
 	}
 }
 
+bool NativeWindow::apply_startup_style(int32_t window_id, const StartupStyle& style) {
+	TRACE_SCOPE("NativeWindow::apply_startup_style");
+
+	HWND hwnd = ::get_native_handle(window_id);
+	if (hwnd == NULL) {
+		print_error("Failed to get native handle.");
+		return false;
+	}
+
+	// Style attributes don't fail the startup style. The window just keeps the default look.
+	::set_backdrop(hwnd, style.backdrop);
+	::set_corner(hwnd, style.corner);
+	::set_color(hwnd, DWMWA_BORDER_COLOR, style.border_color);
+	::set_color(hwnd, DWMWA_CAPTION_COLOR, style.title_bar_color);
+	::set_color(hwnd, DWMWA_TEXT_COLOR, style.text_color);
+
+	return Super::apply_startup_style(window_id, style);
+}
+
+bool NativeWindow::start_message_recording(const char* path) {
+	std::lock_guard<std::mutex> guard(recorder_mutex);
+
+	if (!recorder.start(path)) {
+		print_error("Failed to start recording messages to %s.", path);
+		return false;
+	}
+
+	recording.store(true, std::memory_order_relaxed);
+
+	return true;
+}
+
+bool NativeWindow::stop_message_recording() {
+	std::lock_guard<std::mutex> guard(recorder_mutex);
+
+	recording.store(false, std::memory_order_relaxed);
+
+	if (!recorder.stop()) {
+		print_error("Failed to write the message recording.");
+		return false;
+	}
+
+	return true;
+}
+
 bool NativeWindow::is_valid() const {
-	return hwnd != NULL;
+	return hwnd != NULL || (window && window->is_embedded());
 }
 
 void NativeWindow::on_ready() {
+	EMBEDDED_GUARD(Super::on_ready());
+
 	if (!::subclass_wndproc(acrylic_window, hwnd))
 		print_error("Failed to subclass wndproc.");
 }
 
 void NativeWindow::on_exit_tree() {
+	EMBEDDED_GUARD(Super::on_exit_tree());
+
 	if (!::restore_wndproc(hwnd))
 		print_error("Failed to restore wndproc.");
 }
 
 bool NativeWindow::minimize() {
+	EMBEDDED_GUARD(Super::minimize());
+
 	if (!ShowWindow(hwnd, SW_MINIMIZE)) {
 		print_error("Failed to ShowWindow. Error: %d.", GetLastError());
 		return false;
@@ -468,6 +562,8 @@ bool NativeWindow::minimize() {
 }
 
 bool NativeWindow::maximize(bool toggle) {
+	EMBEDDED_GUARD(Super::maximize(toggle));
+
 	int show_command = SW_MAXIMIZE;
 	if (toggle) {
 		WINDOWPLACEMENT placement = {};
@@ -490,6 +586,9 @@ bool NativeWindow::maximize(bool toggle) {
 }
 
 bool NativeWindow::close() {
+	EMBEDDED_GUARD(Super::close());
+
+	// Godot turns WM_CLOSE into close_requested of this window.
 	if (!PostMessage(hwnd, WM_CLOSE, 0, 0)) {
 		print_error("Failed to PostMessage(WM_CLOSE). Error: %d.", GetLastError());
 		return false;
@@ -499,6 +598,11 @@ bool NativeWindow::close() {
 }
 
 bool NativeWindow::set_always_on_top(const bool p_always_on_top) {
+	TRACE_SCOPE("NativeWindow::set_always_on_top");
+
+	EMBEDDED_GUARD(Super::set_always_on_top(p_always_on_top));
+
+	monitor_native_call();
 	if (!SetWindowPos(hwnd, p_always_on_top ? HWND_TOPMOST : HWND_NOTOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE)) {
 		print_error("Failed to SetWindowPos. Error: %d", GetLastError());
 		return false;
@@ -508,8 +612,13 @@ bool NativeWindow::set_always_on_top(const bool p_always_on_top) {
 }
 
 bool NativeWindow::set_frame(const AcrylicWindow::Frame p_frame) {
+	TRACE_SCOPE("NativeWindow::set_frame");
+
+	EMBEDDED_GUARD(Super::set_frame(p_frame));
+
 	print_debug("New Frame: %d", p_frame);
 #if TRUE
+	monitor_native_call();
 	if (!SetWindowPos(hwnd, NULL, 0, 0, 0, 0, SWP_FRAMECHANGED | SWP_NOMOVE | SWP_NOSIZE)) {
 		print_warning("Failed to notify SWP_FRAMECHANGED. Error: %d.", GetLastError());
 		return false;
@@ -572,108 +681,83 @@ bool NativeWindow::set_frame(const AcrylicWindow::Frame p_frame) {
 }
 
 bool NativeWindow::set_backdrop(const AcrylicWindow::Backdrop p_backdrop) {
-	bool apply = false;
+	TRACE_SCOPE("NativeWindow::set_backdrop");
 
-	int new_backdrop = DWMSBT_AUTO;
-	switch (p_backdrop) {
-	case AcrylicWindow::BACKDROP_SOLID:
-		new_backdrop = DWMSBT_AUTO;
-		break;
-	case AcrylicWindow::BACKDROP_TRANSPARENT:
-		new_backdrop = DWMSBT_NONE;
-		break;
-	case AcrylicWindow::BACKDROP_ACRYLIC:
-		new_backdrop = DWMSBT_TRANSIENTWINDOW;
-		break;
-	case AcrylicWindow::BACKDROP_MICA:
-		new_backdrop = DWMSBT_MAINWINDOW;
-		break;
-	case AcrylicWindow::BACKDROP_TABBED:
-		new_backdrop = DWMSBT_TABBEDWINDOW;
-		break;
-	}
+	EMBEDDED_GUARD(Super::set_backdrop(p_backdrop));
 
-	int old_backdrop = DWMSBT_AUTO;
-	HRESULT hresult = DwmGetWindowAttribute(hwnd, DWMWA_SYSTEMBACKDROP_TYPE, &old_backdrop, sizeof(old_backdrop));
-	if (FAILED(hresult)) {
-		print_error("Failed to get DWMWA_SYSTEMBACKDROP_TYPE. Error: %d.", hresult);
-		apply = true;
-	}
-	else {
-		apply = new_backdrop != old_backdrop;
-	}
-
-	if (apply) {
-		print_debug("Setting the new backdrop %d. The current backdrop is %d.", new_backdrop, old_backdrop);
-
-		hresult = DwmSetWindowAttribute(hwnd, DWMWA_SYSTEMBACKDROP_TYPE, &new_backdrop, sizeof(new_backdrop));
-		if (FAILED(hresult)) {
-			print_error("Failed to set DWMWA_SYSTEMBACKDROP_TYPE. Error: %d.", hresult);
-			return false;
-		}
-	}
-	else {
-		print_debug("The new backdrop is the same as the old one. No changes made.");
-	}
+	if (!::set_backdrop(hwnd, p_backdrop))
+		return false;
 
 	return Super::set_backdrop(p_backdrop);
 }
 
 bool NativeWindow::set_corner(const AcrylicWindow::Corner p_corner) {
-	UINT value = DWMWCP_DEFAULT;
-	switch (p_corner) {
-	case AcrylicWindow::CORNER_DONT_ROUND:
-		value = DWMWCP_DONOTROUND;
-		break;
-	case AcrylicWindow::CORNER_ROUND:
-		value = DWMWCP_ROUND;
-		break;
-	case AcrylicWindow::CORNER_ROUND_SMALL:
-		value = DWMWCP_ROUNDSMALL;
-		break;
-	}
+	TRACE_SCOPE("NativeWindow::set_corner");
 
-	HRESULT hresult = DwmSetWindowAttribute(hwnd, DWMWA_WINDOW_CORNER_PREFERENCE, &value, sizeof(value));
-	if (FAILED(hresult)) {
-		print_error("Failed to set corner = %d. Error: %d.", value, hresult);
-		return false;
-	}
+	EMBEDDED_GUARD(Super::set_corner(p_corner));
 
-	return true;
+	return ::set_corner(hwnd, p_corner);
 }
 
 bool NativeWindow::set_autohide_title_bar(const AcrylicWindow::Autohide p_autohide_title_bar) {
+	TRACE_SCOPE("NativeWindow::set_autohide_title_bar");
+
 	return true;
 }
 
 bool NativeWindow::set_accent_title_bar(const AcrylicWindow::Accent p_accent_title_bar) {
+	TRACE_SCOPE("NativeWindow::set_accent_title_bar");
+
 	return true;
 }
 
 bool NativeWindow::set_auto_colors(const bool p_auto_colors) {
+	TRACE_SCOPE("NativeWindow::set_auto_colors");
+
 	return true;
 }
 
 bool NativeWindow::set_base_color(const Color& p_base_color) {
+	TRACE_SCOPE("NativeWindow::set_base_color");
+
 	return true;
 }
 
 bool NativeWindow::set_border_color(const Color& p_border_color) {
+	TRACE_SCOPE("NativeWindow::set_border_color");
+
+	EMBEDDED_GUARD(Super::set_border_color(p_border_color));
+
 	return ::set_color(hwnd, DWMWA_BORDER_COLOR, p_border_color);
 }
 
 bool NativeWindow::set_title_bar_color(const Color& p_title_bar_color) {
+	TRACE_SCOPE("NativeWindow::set_title_bar_color");
+
+	EMBEDDED_GUARD(Super::set_title_bar_color(p_title_bar_color));
+
 	return ::set_color(hwnd, DWMWA_CAPTION_COLOR, p_title_bar_color);
 }
 
 bool NativeWindow::set_text_color(const Color& p_text_color) {
+	TRACE_SCOPE("NativeWindow::set_text_color");
+
+	EMBEDDED_GUARD(Super::set_text_color(p_text_color));
+
 	return ::set_color(hwnd, DWMWA_TEXT_COLOR, p_text_color);
 }
 
 bool NativeWindow::set_clear_color(const Color& p_clear_color) {
+	TRACE_SCOPE("NativeWindow::set_clear_color");
+
 	return Super::set_clear_color(p_clear_color);
 }
 
+// WM_NCHITTEST of the subclassed window.
+bool NativeWindow::has_hit_test() const {
+	return hwnd != NULL;
+}
+
 } // namespace godot
 
 #endif // _WIN32
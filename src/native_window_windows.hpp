@@ -27,6 +27,12 @@ class NativeWindow : public NativeWindowBase {
 public:
 	NativeWindow(AcrylicWindow* acrylic_window);
 
+public:
+	static bool apply_startup_style(int32_t window_id, const StartupStyle& style);
+
+	static bool start_message_recording(const char* path);
+	static bool stop_message_recording();
+
 public:
 	bool is_valid() const;
 
@@ -53,6 +59,9 @@ public:
 	bool set_text_color(const Color& p_text_color);
 	bool set_clear_color(const Color& p_clear_color);
 
+public:
+	bool has_hit_test() const;
+
 protected:
 	HWND hwnd;
 };
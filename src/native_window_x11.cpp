@@ -0,0 +1,466 @@
+/**************************************************************************/
+/*  native_window_x11.cpp                                                 */
+/*                                                                        */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "native_window_x11.hpp"
+
+#if defined(__linux__) && defined(ACRYLIC_X11)
+
+#include "core/window_registry.hpp"
+#include "core/x11_hints.hpp"
+#include "trace.hpp"
+
+#include <godot_cpp/classes/display_server.hpp>
+#include <godot_cpp/classes/window.hpp>
+
+#include <vector>
+
+// Xlib comes after Godot headers because it defines macros like None and Status.
+#include <X11/Xatom.h>
+#include <X11/Xlib.h>
+
+// Windows that aren't X11 windows of their own use NativeWindowBase.
+#define X11_GUARD(super_call)	\
+	if (xwindow == 0)			\
+		return super_call;
+
+// godot::Window and the X11 Window clash, so X11 windows are ::Window below.
+using namespace godot;
+
+namespace {
+	constexpr char PRINT_CATEGORY[] = "AcrylicWindow";
+
+	static_assert(int(acrylic::FRAME_CUSTOM) == int(AcrylicWindow::FRAME_CUSTOM),
+		"acrylic::Frame is out of sync with AcrylicWindow::Frame.");
+
+	enum AtomIndex {
+		ATOM_MOTIF_WM_HINTS,
+		ATOM_NET_SUPPORTING_WM_CHECK,
+		ATOM_NET_WM_STATE,
+		ATOM_NET_WM_STATE_ABOVE,
+		ATOM_NET_WM_WINDOW_TYPE,
+		ATOM_NET_WM_WINDOW_TYPE_NORMAL,
+		ATOM_NET_WM_WINDOW_TYPE_DIALOG,
+		ATOM_NET_WM_WINDOW_TYPE_UTILITY,
+		ATOM_NET_WM_OPAQUE_REGION,
+		ATOM_KDE_NET_WM_BLUR_BEHIND_REGION,
+		ATOM_MAX
+	};
+
+	const char* ATOM_NAMES[ATOM_MAX] = {
+		"_MOTIF_WM_HINTS",
+		"_NET_SUPPORTING_WM_CHECK",
+		"_NET_WM_STATE",
+		"_NET_WM_STATE_ABOVE",
+		"_NET_WM_WINDOW_TYPE",
+		"_NET_WM_WINDOW_TYPE_NORMAL",
+		"_NET_WM_WINDOW_TYPE_DIALOG",
+		"_NET_WM_WINDOW_TYPE_UTILITY",
+		"_NET_WM_OPAQUE_REGION",
+		"_KDE_NET_WM_BLUR_BEHIND_REGION"
+	};
+
+	constexpr long NET_WM_STATE_REMOVE = 0;
+	constexpr long NET_WM_STATE_ADD = 1;
+	constexpr long NET_WM_SOURCE_APPLICATION = 1;
+
+	// Godot opens one X11 display for all its windows.
+	struct display_s {
+		bool checked = false;
+		Display* display = nullptr;
+		Atom atoms[ATOM_MAX] = {};
+		// The window manager owns _NET_WM_STATE of mapped windows and must be asked
+		// to change it. Without one (e.g. bare Xvfb) the property is written directly.
+		bool has_window_manager = false;
+		// The _NET_SUPPORTING_WM_CHECK window. A new one means the window manager
+		// has restarted or changed.
+		::Window window_manager = 0;
+	};
+
+	struct x11_window_s {
+		acrylic::X11PropertyBatch batch;
+		bool queued = false;
+	};
+
+	// Touched only on the main thread.
+	display_s x11;
+	acrylic::WindowRegistry<x11_window_s> windows;
+	std::vector<uint64_t> queued_windows;
+
+	// Returns the _NET_SUPPORTING_WM_CHECK window or 0 without a window manager.
+	::Window get_window_manager(Display* display) {
+		Atom type = 0;
+		int format = 0;
+		unsigned long count = 0;
+		unsigned long remaining = 0;
+		unsigned char* data = nullptr;
+
+		monitor_round_trip();
+		int result = XGetWindowProperty(display, DefaultRootWindow(display), x11.atoms[ATOM_NET_SUPPORTING_WM_CHECK],
+			0, 1, False, XA_WINDOW, &type, &format, &count, &remaining, &data);
+
+		::Window window_manager = 0;
+		if (result == Success && type == XA_WINDOW && count == 1 && data)
+			window_manager = *reinterpret_cast<const ::Window*>(data);
+
+		if (data)
+			XFree(data);
+
+		return window_manager;
+	}
+
+	// Interns the atoms and checks for a window manager. The only round trips
+	// of this backend besides focus changes and _NET_WM_STATE updates without
+	// a window manager.
+	bool init_display(Display* display) {
+		TRACE_SCOPE("NativeWindow::init_display");
+
+		monitor_round_trip();
+		if (!XInternAtoms(display, const_cast<char**>(ATOM_NAMES), ATOM_MAX, False, x11.atoms)) {
+			print_error("Failed to XInternAtoms.");
+			return false;
+		}
+
+		x11.window_manager = get_window_manager(display);
+		x11.has_window_manager = x11.window_manager != 0;
+
+		x11.display = display;
+		return true;
+	}
+
+	// Returns null if Godot doesn't run on X11.
+	Display* get_display() {
+		if (x11.checked)
+			return x11.display;
+
+		x11.checked = true;
+
+		DisplayServer* display_server = DisplayServer::get_singleton();
+		if (!display_server) {
+			print_error("Failed to get display server.");
+			return nullptr;
+		}
+
+		// Wayland and headless.
+		if (display_server->get_name() != "X11")
+			return nullptr;
+
+		int64_t handle = display_server->window_get_native_handle(DisplayServer::DISPLAY_HANDLE, DisplayServer::MAIN_WINDOW_ID);
+		Display* display = reinterpret_cast<Display*>(handle);
+		if (!display) {
+			print_error("Failed to get X11 display.");
+			return nullptr;
+		}
+
+		if (!init_display(display))
+			return nullptr;
+
+		return x11.display;
+	}
+
+	void write_motif_hints(::Window xwindow, acrylic::Frame frame) {
+		acrylic::MotifHints hints = acrylic::get_motif_hints(frame);
+
+		// Format 32 data is an array of longs on the client side.
+		long data[5] = {
+			static_cast<long>(hints.flags),
+			static_cast<long>(hints.functions),
+			static_cast<long>(hints.decorations),
+			static_cast<long>(hints.input_mode),
+			static_cast<long>(hints.status)
+		};
+
+		Atom atom = x11.atoms[ATOM_MOTIF_WM_HINTS];
+		XChangeProperty(x11.display, xwindow, atom, atom, 32, PropModeReplace, reinterpret_cast<unsigned char*>(data), 5);
+	}
+
+	void write_state_above(::Window xwindow, bool above) {
+		Atom state = x11.atoms[ATOM_NET_WM_STATE];
+		Atom state_above = x11.atoms[ATOM_NET_WM_STATE_ABOVE];
+
+		if (x11.has_window_manager) {
+			XEvent event = {};
+			event.xclient.type = ClientMessage;
+			event.xclient.window = xwindow;
+			event.xclient.message_type = state;
+			event.xclient.format = 32;
+			event.xclient.data.l[0] = above ? NET_WM_STATE_ADD : NET_WM_STATE_REMOVE;
+			event.xclient.data.l[1] = static_cast<long>(state_above);
+			event.xclient.data.l[3] = NET_WM_SOURCE_APPLICATION;
+
+			XSendEvent(x11.display, DefaultRootWindow(x11.display), False,
+				SubstructureRedirectMask | SubstructureNotifyMask, &event);
+			return;
+		}
+
+		// Keep the other states.
+		Atom type = 0;
+		int format = 0;
+		unsigned long count = 0;
+		unsigned long remaining = 0;
+		unsigned char* data = nullptr;
+		std::vector<Atom> states;
+
+		monitor_round_trip();
+		int result = XGetWindowProperty(x11.display, xwindow, state, 0, 1024, False, XA_ATOM,
+			&type, &format, &count, &remaining, &data);
+		if (result == Success && data && format == 32) {
+			const Atom* atoms = reinterpret_cast<const Atom*>(data);
+			for (unsigned long i = 0; i < count; i++) {
+				if (atoms[i] != state_above)
+					states.push_back(atoms[i]);
+			}
+		}
+
+		if (data)
+			XFree(data);
+
+		if (above)
+			states.push_back(state_above);
+
+		XChangeProperty(x11.display, xwindow, state, XA_ATOM, 32, PropModeReplace,
+			reinterpret_cast<unsigned char*>(states.data()), static_cast<int>(states.size()));
+	}
+
+	void write_window_type(::Window xwindow, acrylic::X11WindowType window_type) {
+		Atom atom = x11.atoms[ATOM_NET_WM_WINDOW_TYPE_NORMAL];
+		if (window_type == acrylic::X11_WINDOW_TYPE_DIALOG)
+			atom = x11.atoms[ATOM_NET_WM_WINDOW_TYPE_DIALOG];
+		else if (window_type == acrylic::X11_WINDOW_TYPE_UTILITY)
+			atom = x11.atoms[ATOM_NET_WM_WINDOW_TYPE_UTILITY];
+
+		XChangeProperty(x11.display, xwindow, x11.atoms[ATOM_NET_WM_WINDOW_TYPE], XA_ATOM, 32, PropModeReplace,
+			reinterpret_cast<unsigned char*>(&atom), 1);
+	}
+
+	// Both region properties are CARDINAL x, y, width, height per rect.
+	// KWin blurs the whole window if the blur region is empty, so an empty
+	// region removes the property instead.
+	void write_region(::Window xwindow, AtomIndex atom, bool present, const std::vector<acrylic::Rect>& region) {
+		if (!present) {
+			XDeleteProperty(x11.display, xwindow, x11.atoms[atom]);
+			return;
+		}
+
+		std::vector<long> data;
+		data.reserve(region.size() * 4);
+		for (const acrylic::Rect& rect : region) {
+			data.push_back(rect.left);
+			data.push_back(rect.top);
+			data.push_back(rect.right - rect.left);
+			data.push_back(rect.bottom - rect.top);
+		}
+
+		XChangeProperty(x11.display, xwindow, x11.atoms[atom], XA_CARDINAL, 32, PropModeReplace,
+			reinterpret_cast<unsigned char*>(data.data()), static_cast<int>(data.size()));
+	}
+
+	void write_properties(uint64_t key, acrylic::X11PropertyBatch& batch) {
+		::Window xwindow = static_cast<::Window>(key);
+		uint32_t dirty = batch.take_dirty();
+
+		if (dirty & acrylic::X11_PROPERTY_MOTIF_HINTS)
+			write_motif_hints(xwindow, batch.get_frame());
+
+		if (dirty & acrylic::X11_PROPERTY_STATE_ABOVE)
+			write_state_above(xwindow, batch.is_above());
+
+		if (dirty & acrylic::X11_PROPERTY_WINDOW_TYPE)
+			write_window_type(xwindow, batch.get_window_type());
+
+		if (dirty & acrylic::X11_PROPERTY_OPAQUE_REGION)
+			write_region(xwindow, ATOM_NET_WM_OPAQUE_REGION, !batch.get_opaque_region().empty(), batch.get_opaque_region());
+
+		if (dirty & acrylic::X11_PROPERTY_BLUR_REGION)
+			write_region(xwindow, ATOM_KDE_NET_WM_BLUR_BEHIND_REGION, batch.has_blur() && !batch.get_blur_region().empty(), batch.get_blur_region());
+	}
+
+	// Called deferred, so all the changes of a frame are written together.
+	void flush_windows() {
+		TRACE_SCOPE("NativeWindow::flush_windows");
+
+		bool written = false;
+		for (uint64_t key : queued_windows) {
+			x11_window_s* state = windows.find(key);
+			if (!state)
+				continue;
+
+			state->queued = false;
+			if (!state->batch.get_dirty())
+				continue;
+
+			write_properties(key, state->batch);
+			written = true;
+		}
+
+		queued_windows.clear();
+
+		if (written) {
+			monitor_native_call();
+			XFlush(x11.display);
+		}
+	}
+
+	x11_window_s* get_state(uint64_t key) {
+		x11_window_s* state = windows.find(key);
+		if (state)
+			return state;
+
+		return windows.insert(key, x11_window_s());
+	}
+
+	// Keeps the flags of godot::Window in sync with the properties written here.
+	// Godot rewrites _MOTIF_WM_HINTS and _NET_WM_STATE from its flags on its
+	// own mode changes, so stale flags would undo them.
+	// Returns true if the flag has changed. Godot has then written the property
+	// too and the batch must write it again.
+	bool sync_flag(godot::Window* window, godot::Window::Flags flag, bool enabled) {
+		if (window->get_flag(flag) == enabled)
+			return false;
+
+		monitor_native_call();
+		window->set_flag(flag, enabled);
+		return true;
+	}
+
+	void queue_flush(uint64_t key, x11_window_s* state) {
+		if (state->queued)
+			return;
+
+		state->queued = true;
+		if (queued_windows.empty())
+			callable_mp_static(&flush_windows).call_deferred();
+
+		queued_windows.push_back(key);
+	}
+}
+
+namespace godot {
+
+NativeWindow::NativeWindow(AcrylicWindow* acrylic_window)
+	: Super(acrylic_window)
+{
+	// Embedded windows are drawn into the X11 window of their embedder.
+	if (!window || window->is_embedded())
+		return;
+
+	if (!get_display())
+		return;
+
+	DisplayServer* display_server = DisplayServer::get_singleton();
+	int64_t handle = display_server->window_get_native_handle(DisplayServer::WINDOW_HANDLE, window->get_window_id());
+	xwindow = static_cast<uint64_t>(handle);
+}
+
+void NativeWindow::on_ready() {
+	X11_GUARD(Super::on_ready());
+
+	// Undecorated windows are sometimes treated as splash screens without this.
+	x11_window_s* state = get_state(xwindow);
+	if (state->batch.set_window_type(acrylic::X11_WINDOW_TYPE_NORMAL))
+		queue_flush(xwindow, state);
+}
+
+void NativeWindow::on_exit_tree() {
+	X11_GUARD(Super::on_exit_tree());
+
+	windows.erase(xwindow);
+}
+
+// Godot rewrites _MOTIF_WM_HINTS and _NET_WM_STATE on mode changes.
+void NativeWindow::on_mode_changed() {
+	X11_GUARD(Super::on_mode_changed());
+
+	x11_window_s* state = windows.find(xwindow);
+	if (!state)
+		return;
+
+	state->batch.invalidate();
+	if (state->batch.get_dirty())
+		queue_flush(xwindow, state);
+}
+
+// A restarted window manager may have dropped the state of the windows.
+// One round trip per focus change, rare enough to not be noticed.
+void NativeWindow::on_focus_in() {
+	TRACE_SCOPE("NativeWindow::on_focus_in");
+
+	X11_GUARD(Super::on_focus_in());
+
+	::Window window_manager = get_window_manager(x11.display);
+	if (window_manager == x11.window_manager)
+		return;
+
+	x11.window_manager = window_manager;
+	x11.has_window_manager = window_manager != 0;
+
+	windows.for_each([](uint64_t key, x11_window_s& state) {
+		state.batch.invalidate();
+		if (state.batch.get_dirty())
+			queue_flush(key, &state);
+	});
+}
+
+bool NativeWindow::set_always_on_top(const bool p_always_on_top) {
+	TRACE_SCOPE("NativeWindow::set_always_on_top");
+
+	X11_GUARD(Super::set_always_on_top(p_always_on_top));
+
+	x11_window_s* state = get_state(xwindow);
+	if (sync_flag(window, godot::Window::FLAG_ALWAYS_ON_TOP, p_always_on_top))
+		state->batch.invalidate();
+
+	if (state->batch.set_above(p_always_on_top) || state->batch.get_dirty())
+		queue_flush(xwindow, state);
+
+	return true;
+}
+
+bool NativeWindow::set_frame(const AcrylicWindow::Frame p_frame) {
+	TRACE_SCOPE("NativeWindow::set_frame");
+
+	X11_GUARD(Super::set_frame(p_frame));
+
+	// The default frame doesn't take the decorations away from Linux windows.
+	if (!acrylic_window->frame_set)
+		return true;
+
+	x11_window_s* state = get_state(xwindow);
+	if (sync_flag(window, godot::Window::FLAG_BORDERLESS, p_frame != AcrylicWindow::FRAME_DEFAULT))
+		state->batch.invalidate();
+
+	if (state->batch.set_frame(static_cast<acrylic::Frame>(p_frame)) || state->batch.get_dirty())
+		queue_flush(xwindow, state);
+
+	return true;
+}
+
+bool NativeWindow::has_regions() const {
+	return xwindow != 0;
+}
+
+bool NativeWindow::set_regions(const std::vector<acrylic::Rect>& opaque_region, bool blur, const std::vector<acrylic::Rect>& blur_region) {
+	TRACE_SCOPE("NativeWindow::set_regions");
+
+	X11_GUARD(Super::set_regions(opaque_region, blur, blur_region));
+
+	x11_window_s* state = get_state(xwindow);
+	bool dirty = state->batch.set_opaque_region(opaque_region);
+	dirty = state->batch.set_blur_region(blur, blur_region) || dirty;
+	if (dirty)
+		queue_flush(xwindow, state);
+
+	return true;
+}
+
+} // namespace godot
+
+#endif // __linux__ && ACRYLIC_X11
@@ -0,0 +1,54 @@
+/**************************************************************************/
+/*  native_window_x11.hpp                                                 */
+/*                                                                        */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#if defined(__linux__) && defined(ACRYLIC_X11)
+
+#include "native_window_base.hpp"
+
+namespace godot {
+
+// Writes _MOTIF_WM_HINTS, _NET_WM_STATE, _NET_WM_WINDOW_TYPE,
+// _NET_WM_OPAQUE_REGION and _KDE_NET_WM_BLUR_BEHIND_REGION directly.
+// Changes are batched per window and written once per frame with a single
+// XFlush. Steady state updates make no round trips to the X server.
+//
+// On Wayland and for embedded windows everything goes to NativeWindowBase.
+class NativeWindow : public NativeWindowBase {
+	typedef NativeWindowBase Super;
+
+public:
+	NativeWindow(AcrylicWindow* acrylic_window);
+
+public:
+	void on_ready();
+	void on_exit_tree();
+	void on_mode_changed();
+	void on_focus_in();
+
+public:
+	bool set_always_on_top(const bool p_always_on_top);
+	bool set_frame(const AcrylicWindow::Frame p_frame);
+
+public:
+	bool has_regions() const;
+	bool set_regions(const std::vector<acrylic::Rect>& opaque_region, bool blur, const std::vector<acrylic::Rect>& blur_region);
+
+protected:
+	// X11 Window. 0 if the window isn't an X11 window of its own.
+	uint64_t xwindow = 0;
+};
+
+} // namespace godot
+
+#endif // __linux__ && ACRYLIC_X11
@@ -1,6 +1,12 @@
 #include "register_types.hpp"
+#include "acrylic_benchmark.hpp"
+#include "acrylic_binder.hpp"
+#include "acrylic_settings_panel.hpp"
+#include "acrylic_theme.hpp"
 #include "acrylic_window.hpp"
+#include "logger.hpp"
 #include "scrollable_option_button.hpp"
+#include "startup.hpp"
 #include "switch_tween.hpp"
 
 #include <gdextension_interface.h>
@@ -14,15 +20,30 @@ void initialize_module(ModuleInitializationLevel p_level) {
 		return;
 	}
 
+	register_log_settings();
+	register_monitors();
+	register_startup_settings();
+
 	ClassDB::register_class<AcrylicWindow>();
+	ClassDB::register_class<AcrylicTheme>();
+	ClassDB::register_class<AcrylicBenchmark>();
 	ClassDB::register_class<ScrollableOptionButton>();
 	ClassDB::register_class<SwitchTween>();
+	ClassDB::register_class<AcrylicBinder>();
+	ClassDB::register_class<AcrylicSettingsPanel>();
 }
 
 void uninitialize_module(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
+
+	unregister_startup_settings();
+	unregister_monitors();
+	unregister_log_settings();
+
+	// Write pending messages before the library is unloaded.
+	log_shutdown();
 }
 
 extern "C" {
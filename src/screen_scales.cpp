@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*  screen_scales.cpp                                                     */
+/*  Cached scale of every screen for per-monitor text size.               */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "screen_scales.hpp"
+
+#include "core/screen_scale.hpp"
+#include "helpers.hpp"
+#include "trace.hpp"
+
+#include <godot_cpp/classes/display_server.hpp>
+
+#include <vector>
+
+using namespace godot;
+
+namespace {
+	constexpr char PRINT_CATEGORY[] = "AcrylicWindow";
+
+	// Touched only on the main thread.
+	std::vector<float> screen_scales;
+	bool screen_scales_valid = false;
+	uint32_t screen_scales_generation = 0;
+
+	float query_screen_scale(DisplayServer* display_server, int screen) {
+		// macOS and Wayland report the scale directly. The others report 1.
+		float scale = display_server->screen_get_scale(screen);
+		if (scale != 1)
+			return scale;
+
+		return acrylic::get_dpi_scale(display_server->screen_get_dpi(screen));
+	}
+
+	void build_screen_scales() {
+		TRACE_SCOPE("build_screen_scales");
+
+		screen_scales.clear();
+		screen_scales_valid = true;
+
+		DisplayServer* display_server = DisplayServer::get_singleton();
+		if (!display_server) {
+			print_error("Failed to get display server.");
+			return;
+		}
+
+		int screen_count = display_server->get_screen_count();
+		screen_scales.reserve(screen_count);
+		for (int i = 0; i < screen_count; i++) {
+			monitor_native_call();
+			screen_scales.push_back(query_screen_scale(display_server, i));
+			print_debug("Screen %d scale: %.2f.", i, screen_scales.back());
+		}
+	}
+}
+
+namespace godot {
+
+float get_screen_scale(int screen) {
+	if (!screen_scales_valid)
+		build_screen_scales();
+
+	// A screen that has been connected since the table was built.
+	if (screen >= static_cast<int>(screen_scales.size()))
+		build_screen_scales();
+
+	if (screen < 0 || screen >= static_cast<int>(screen_scales.size()))
+		return 1;
+
+	return screen_scales[screen];
+}
+
+void invalidate_screen_scales() {
+	screen_scales_valid = false;
+	screen_scales_generation++;
+}
+
+uint32_t get_screen_scales_generation() {
+	return screen_scales_generation;
+}
+
+}
@@ -0,0 +1,31 @@
+/**************************************************************************/
+/*  screen_scales.hpp                                                     */
+/*  Cached scale of every screen for per-monitor text size.               */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace godot {
+
+// Scale of the screen relative to 96 DPI, see acrylic::get_dpi_scale.
+// The table is built on first use and kept until invalidate_screen_scales
+// is called.
+float get_screen_scale(int screen);
+
+// Call when screens are added, removed or change their DPI.
+void invalidate_screen_scales();
+
+// Changes with every invalidate_screen_scales. A screen index remembered
+// with an older generation may now be another screen or have another scale.
+uint32_t get_screen_scales_generation();
+
+}
@@ -13,11 +13,37 @@
 #include "scrollable_option_button.hpp"
 
 #include "helpers.hpp"
+#include "trace.hpp"
 
+#include <godot_cpp/classes/button.hpp>
+#include <godot_cpp/classes/h_box_container.hpp>
 #include <godot_cpp/classes/input_event_mouse_button.hpp>
+#include <godot_cpp/classes/popup_menu.hpp>
+#include <godot_cpp/classes/popup_panel.hpp>
+#include <godot_cpp/classes/text_server.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/v_scroll_bar.hpp>
+
+#include <algorithm>
+#include <cmath>
 
 namespace {
-	const char PRINT_CATEGORY[] = "ScrollableOptionButton";
+	constexpr char PRINT_CATEGORY[] = "ScrollableOptionButton";
+
+	// Max rows visible in the virtual popup.
+	constexpr int VIRTUAL_VISIBLE_ROWS = 16;
+
+	// Rows scrolled by one wheel step in the virtual popup.
+	constexpr int VIRTUAL_WHEEL_ROWS = 3;
+
+	// Wheel events closer in time belong to one gesture.
+	constexpr uint64_t WHEEL_GESTURE_INTERVAL = 150000; // usec
+	constexpr int WHEEL_MAX_STREAK = 20;
+
+	// Devices that don't report the factor send 0.
+	float get_wheel_factor(const godot::Ref<godot::InputEventMouseButton>& mb) {
+		return mb->get_factor() > 0 ? mb->get_factor() : 1;
+	}
 }
 
 namespace godot {
@@ -25,34 +51,481 @@ namespace godot {
 void ScrollableOptionButton::_gui_input(const Ref<InputEvent>& event) {
 	ERR_FAIL_COND(event.is_null());
 
+	Ref<InputEventKey> key = event;
+	int32_t typed_item = -1;
+	if (key.is_valid() && type_ahead(key, get_current_index(), &typed_item)) {
+		if (typed_item >= 0 && typed_item != get_current_index())
+			select_and_emit(typed_item);
+
+		accept_event();
+		return;
+	}
+
 	Ref<InputEventMouseButton> mb = event;
 
 	if (mb.is_valid()) {
-		if (mb->is_pressed()) {
-			int32_t new_item_index = -1;
+		if (mb->is_pressed() && get_current_count() > 0) {
 			switch (mb->get_button_index()) {
 				case MOUSE_BUTTON_WHEEL_UP:
-					new_item_index = get_selected() - 1;
-					break;
+					add_wheel_steps(-get_wheel_factor(mb));
+					accept_event();
+					return;
 
 				case MOUSE_BUTTON_WHEEL_DOWN:
-					new_item_index = get_selected() + 1;
+					add_wheel_steps(get_wheel_factor(mb));
+					accept_event();
+					return;
+
+				case MOUSE_BUTTON_LEFT:
+					// Don't let OptionButton open its own popup.
+					if (virtual_mode) {
+						show_virtual_popup();
+						accept_event();
+						return;
+					}
 					break;
 			}
+		}
+	}
+
+	if (virtual_mode && event->is_action_pressed("ui_accept")) {
+		show_virtual_popup();
+		accept_event();
+		return;
+	}
+
+	OptionButton::_gui_input(event);
+}
+
+void ScrollableOptionButton::_notification(int p_what) {
+	if (p_what == NOTIFICATION_PROCESS) {
+		apply_wheel_steps();
+		return;
+	}
+
+	if (p_what != NOTIFICATION_READY)
+		return;
+
+	// Replace the linear search of PopupMenu with the index.
+	PopupMenu* popup = get_popup();
+	popup->set_allow_search(false);
+
+	Callable on_menu_changed = callable_mp(this, &ScrollableOptionButton::invalidate_search_index);
+	if (!popup->is_connected("menu_changed", on_menu_changed))
+		popup->connect("menu_changed", on_menu_changed);
+
+	Callable on_input = callable_mp(this, &ScrollableOptionButton::on_popup_input);
+	if (!popup->is_connected("window_input", on_input))
+		popup->connect("window_input", on_input);
+}
+
+void ScrollableOptionButton::_bind_methods() {
+	BIND_PROPERTY(ScrollableOptionButton, Variant::BOOL, virtual_mode);
+	BIND_PROPERTY(ScrollableOptionButton, Variant::PACKED_STRING_ARRAY, virtual_items);
+	BIND_PROPERTY(ScrollableOptionButton, Variant::INT, virtual_selected);
+	BIND_PROPERTY(ScrollableOptionButton, Variant::FLOAT, wheel_acceleration);
+
+	BIND_FUNCTION(ScrollableOptionButton, get_virtual_item_count);
+	BIND_FUNCTION(ScrollableOptionButton, get_virtual_item_text, "index");
+}
+
+#pragma region PROPERTIES
+
+DEFINE_PROPERTY_GET(ScrollableOptionButton, bool, virtual_mode)
+DEFINE_PROPERTY_GET(ScrollableOptionButton, int32_t, virtual_selected)
+DEFINE_PROPERTY_GET(ScrollableOptionButton, float, wheel_acceleration)
+
+DEFINE_PROPERTY_SET(ScrollableOptionButton, float, wheel_acceleration)
+
+void ScrollableOptionButton::set_virtual_mode(const bool p_virtual_mode) {
+	if (virtual_mode == p_virtual_mode)
+		return;
+
+	virtual_mode = p_virtual_mode;
+	invalidate_search_index();
+
+	if (virtual_mode) {
+		clear();
+		set_text(get_virtual_item_text(virtual_selected));
+	}
+	else if (virtual_popup) {
+		virtual_popup->hide();
+	}
+}
+
+void ScrollableOptionButton::set_virtual_selected(const int32_t p_virtual_selected) {
+	virtual_selected = p_virtual_selected >= 0 && p_virtual_selected < get_virtual_item_count() ? p_virtual_selected : -1;
+
+	if (virtual_mode)
+		set_text(get_virtual_item_text(virtual_selected));
 
-			if (new_item_index >= 0 && new_item_index < get_item_count()) {
-				select(new_item_index);
-				//emit_signal(SNAME("item_selected"), get_selected());
-				emit_signal("item_selected", get_selected());
-				return;
+	if (virtual_popup && virtual_popup->is_visible())
+		update_virtual_rows();
+}
+
+void ScrollableOptionButton::set_virtual_items(const PackedStringArray& p_virtual_items) {
+	TRACE_SCOPE("ScrollableOptionButton::set_virtual_items");
+
+	int64_t count = p_virtual_items.size();
+
+	virtual_texts.clear();
+	virtual_texts.reserve(static_cast<size_t>(count), static_cast<size_t>(count) * 16);
+	for (int64_t i = 0; i < count; i++) {
+		CharString text = p_virtual_items[i].utf8();
+		virtual_texts.add(std::string_view(text.get_data(), text.length()));
+	}
+
+	// Rows show the old texts.
+	std::fill(virtual_row_items.begin(), virtual_row_items.end(), -1);
+	virtual_focused = -1;
+	invalidate_search_index();
+
+	set_virtual_selected(std::min<int32_t>(virtual_selected, get_virtual_item_count() - 1));
+}
+
+PackedStringArray ScrollableOptionButton::get_virtual_items() const {
+	PackedStringArray items;
+	items.resize(get_virtual_item_count());
+	for (int32_t i = 0; i < get_virtual_item_count(); i++)
+		items.set(i, get_virtual_item_text(i));
+
+	return items;
+}
+
+int32_t ScrollableOptionButton::get_virtual_item_count() const {
+	return static_cast<int32_t>(virtual_texts.size());
+}
+
+String ScrollableOptionButton::get_virtual_item_text(int32_t index) const {
+	if (index < 0 || index >= get_virtual_item_count())
+		return String();
+
+	std::string_view text = virtual_texts.get(static_cast<size_t>(index));
+	return String::utf8(text.data(), static_cast<int>(text.size()));
+}
+
+#pragma endregion
+
+int32_t ScrollableOptionButton::get_current_index() const {
+	return virtual_mode ? virtual_selected : get_selected();
+}
+
+int32_t ScrollableOptionButton::get_current_count() const {
+	return virtual_mode ? get_virtual_item_count() : get_item_count();
+}
+
+void ScrollableOptionButton::select_and_emit(int32_t index) {
+	if (virtual_mode)
+		set_virtual_selected(index);
+	else
+		select(index);
+
+	//emit_signal(SNAME("item_selected"), get_selected());
+	emit_signal("item_selected", get_current_index());
+}
+
+// Touchpads send many fractional steps per gesture. They add up here and
+// apply_wheel_steps selects once per frame, so item_selected is emitted once.
+void ScrollableOptionButton::add_wheel_steps(float steps) {
+	if (steps == 0)
+		return;
+
+	uint64_t now = Time::get_singleton()->get_ticks_usec();
+
+	// A new gesture or a change of direction drops the leftover fraction.
+	// wheel_steps is often 0 after a whole step, so the direction is kept apart.
+	int8_t direction = steps > 0 ? 1 : -1;
+	if (now - last_wheel_time > WHEEL_GESTURE_INTERVAL || direction != wheel_direction) {
+		wheel_steps = 0;
+		wheel_streak = 0;
+	}
+
+	last_wheel_time = now;
+	wheel_direction = direction;
+	wheel_streak = std::min(wheel_streak + 1, WHEEL_MAX_STREAK);
+	wheel_steps += steps * (1 + wheel_acceleration * (wheel_streak - 1));
+
+	set_process(true);
+}
+
+void ScrollableOptionButton::apply_wheel_steps() {
+	set_process(false);
+
+	int32_t steps = static_cast<int32_t>(wheel_steps);
+	if (steps == 0 || get_current_count() == 0)
+		return;
+
+	wheel_steps -= steps;
+
+	int32_t current = get_current_index();
+	int32_t index = std::clamp(current + steps, 0, get_current_count() - 1);
+	if (index == current) {
+		// Don't keep scrolling past the end.
+		wheel_steps = 0;
+		return;
+	}
+
+	select_and_emit(index);
+}
+
+bool ScrollableOptionButton::type_ahead(const Ref<InputEventKey>& key, int32_t current, int32_t* item) {
+	if (!key->is_pressed() || key->get_unicode() < 32 || key->is_command_or_control_pressed() || key->is_alt_pressed())
+		return false;
+
+	// Space opens the popup unless it continues a query.
+	if (key->get_unicode() == ' ' && typeahead.get_query().empty())
+		return false;
+
+	TRACE_SCOPE("ScrollableOptionButton::type_ahead");
+
+	if (!search_index.is_built()) {
+		if (virtual_mode) {
+			search_index.build(virtual_texts);
+		}
+		else {
+			acrylic::ItemTexts texts;
+			for (int32_t i = 0; i < get_item_count(); i++) {
+				CharString text = get_item_text(i).utf8();
+				texts.add(std::string_view(text.get_data(), text.length()));
 			}
+
+			search_index.build(texts);
 		}
 	}
 
-	OptionButton::_gui_input(event);
+	CharString character = String::chr(key->get_unicode()).utf8();
+	*item = typeahead.type(search_index, std::string_view(character.get_data(), character.length()),
+		Time::get_singleton()->get_ticks_usec(), current);
+
+	return true;
+}
+
+void ScrollableOptionButton::invalidate_search_index() {
+	search_index.clear();
+	typeahead.reset();
+}
+
+void ScrollableOptionButton::on_popup_input(const Ref<InputEvent>& event) {
+	Ref<InputEventKey> key = event;
+	if (key.is_null())
+		return;
+
+	PopupMenu* popup = get_popup();
+	int32_t item = -1;
+	if (!type_ahead(key, popup->get_focused_item(), &item))
+		return;
+
+	if (item >= 0) {
+		popup->set_focused_item(item);
+		popup->scroll_to_item(item);
+	}
+
+	popup->set_input_as_handled();
+}
+
+// Opening costs the same for any number of items: only the visible rows are updated.
+void ScrollableOptionButton::show_virtual_popup() {
+	TRACE_SCOPE("ScrollableOptionButton::show_virtual_popup");
+
+	if (virtual_popup && virtual_popup->is_visible()) {
+		virtual_popup->hide();
+		return;
+	}
+
+	int32_t count = get_virtual_item_count();
+	if (count == 0)
+		return;
+
+	if (!virtual_popup)
+		create_virtual_popup();
+
+	virtual_focused = -1;
+	typeahead.reset();
+
+	// Same placement as the popup of OptionButton.
+	Vector2 scale = get_global_transform_with_canvas().get_scale();
+	Vector2 button_size = get_size() * scale;
+	int visible_rows = std::min(count, VIRTUAL_VISIBLE_ROWS);
+	Vector2 popup_size(button_size.x, visible_rows * virtual_row_height * scale.y);
+
+	virtual_popup->popup(Rect2i(get_screen_position() + Vector2(0, button_size.y), popup_size));
+
+	virtual_scroll_bar->set_max(count * virtual_row_height);
+	virtual_scroll_bar->set_page(visible_rows * virtual_row_height);
+	virtual_scroll_bar->set_value(0);
+	scroll_to_virtual_item(virtual_selected);
+
+	update_virtual_rows();
+}
+
+// Centers the item unless it's fully visible.
+void ScrollableOptionButton::scroll_to_virtual_item(int32_t item) {
+	if (item < 0)
+		return;
+
+	float page = static_cast<float>(virtual_scroll_bar->get_page());
+	float top = item * virtual_row_height;
+	float offset = static_cast<float>(virtual_scroll_bar->get_value());
+	if (top >= offset && top + virtual_row_height <= offset + page)
+		return;
+
+	virtual_scroll_bar->set_value(std::max(0.0f, top - (page - virtual_row_height) / 2));
+}
+
+void ScrollableOptionButton::create_virtual_popup() {
+	virtual_popup = memnew(PopupPanel);
+	monitor_node(virtual_popup);
+	virtual_popup->set_name("VirtualPopup");
+	virtual_popup->connect("window_input", callable_mp(this, &ScrollableOptionButton::on_virtual_popup_input));
+	add_child(virtual_popup, false, INTERNAL_MODE_FRONT);
+
+	HBoxContainer* box = memnew(HBoxContainer);
+	monitor_node(box);
+	virtual_popup->add_child(box);
+
+	virtual_rows_area = memnew(Control);
+	monitor_node(virtual_rows_area);
+	virtual_rows_area->set_clip_contents(true);
+	virtual_rows_area->set_h_size_flags(SIZE_EXPAND_FILL);
+	virtual_rows_area->connect("gui_input", callable_mp(this, &ScrollableOptionButton::on_virtual_rows_input));
+	virtual_rows_area->connect("resized", callable_mp(this, &ScrollableOptionButton::update_virtual_rows));
+	box->add_child(virtual_rows_area);
+
+	virtual_scroll_bar = memnew(VScrollBar);
+	monitor_node(virtual_scroll_bar);
+	virtual_scroll_bar->connect("value_changed", callable_mp(this, &ScrollableOptionButton::update_virtual_rows).unbind(1));
+	box->add_child(virtual_scroll_bar);
+
+	// The first row gives the row height of the current theme.
+	Button* row = create_virtual_row();
+	virtual_row_height = std::max(1.0f, row->get_combined_minimum_size().y);
+	virtual_scroll_bar->set_step(0);
+}
+
+Button* ScrollableOptionButton::create_virtual_row() {
+	Button* row = memnew(Button);
+	monitor_node(row);
+	row->set_flat(true);
+	row->set_toggle_mode(true);
+	row->set_focus_mode(FOCUS_NONE);
+	row->set_text_alignment(HORIZONTAL_ALIGNMENT_LEFT);
+	row->set_text_overrun_behavior(TextServer::OVERRUN_TRIM_ELLIPSIS);
+	row->connect("pressed", callable_mp(this, &ScrollableOptionButton::on_virtual_row_pressed).bind(static_cast<int32_t>(virtual_rows.size())));
+	virtual_rows_area->add_child(row);
+
+	virtual_rows.push_back(row);
+	virtual_row_items.push_back(-1);
+
+	return row;
+}
+
+// Rows are bound to the items under them. Only rows that show
+// another item get a new text.
+void ScrollableOptionButton::update_virtual_rows() {
+	if (!virtual_popup || !virtual_popup->is_visible())
+		return;
+
+	TRACE_SCOPE("ScrollableOptionButton::update_virtual_rows");
+
+	int32_t count = get_virtual_item_count();
+	Vector2 area = virtual_rows_area->get_size();
+	virtual_scroll_bar->set_page(area.y);
+
+	float offset = static_cast<float>(virtual_scroll_bar->get_value());
+	int32_t first_item = static_cast<int32_t>(offset / virtual_row_height);
+	float first_row_y = first_item * virtual_row_height - offset;
+
+	// One more row for the partially visible ones.
+	size_t needed_rows = static_cast<size_t>(std::ceil(area.y / virtual_row_height)) + 1;
+	while (virtual_rows.size() < needed_rows)
+		create_virtual_row();
+
+	for (size_t row_index = 0; row_index < virtual_rows.size(); row_index++) {
+		Button* row = virtual_rows[row_index];
+		int32_t item = first_item + static_cast<int32_t>(row_index);
+
+		if (row_index >= needed_rows || item >= count) {
+			virtual_row_items[row_index] = -1;
+			row->hide();
+			continue;
+		}
+
+		if (virtual_row_items[row_index] != item) {
+			virtual_row_items[row_index] = item;
+			row->set_text(get_virtual_item_text(item));
+		}
+
+		row->set_position(Vector2(0, first_row_y + row_index * virtual_row_height));
+		row->set_size(Vector2(area.x, virtual_row_height));
+		row->set_pressed_no_signal(item == (virtual_focused >= 0 ? virtual_focused : virtual_selected));
+		row->show();
+	}
+}
+
+void ScrollableOptionButton::on_virtual_rows_input(const Ref<InputEvent>& event) {
+	Ref<InputEventMouseButton> mb = event;
+	if (mb.is_null() || !mb->is_pressed())
+		return;
+
+	float step = VIRTUAL_WHEEL_ROWS * virtual_row_height * mb->get_factor();
+	switch (mb->get_button_index()) {
+		case MOUSE_BUTTON_WHEEL_UP:
+			virtual_scroll_bar->set_value(virtual_scroll_bar->get_value() - step);
+			break;
+
+		case MOUSE_BUTTON_WHEEL_DOWN:
+			virtual_scroll_bar->set_value(virtual_scroll_bar->get_value() + step);
+			break;
+
+		default:
+			return;
+	}
+
+	virtual_rows_area->accept_event();
 }
 
-void ScrollableOptionButton::_bind_methods()
-{}
+void ScrollableOptionButton::on_virtual_row_pressed(int32_t row) {
+	int32_t item = virtual_row_items[static_cast<size_t>(row)];
+
+	virtual_popup->hide();
+
+	if (item >= 0)
+		select_and_emit(item);
+}
+
+void ScrollableOptionButton::on_virtual_popup_input(const Ref<InputEvent>& event) {
+	int32_t current = virtual_focused >= 0 ? virtual_focused : virtual_selected;
+	int32_t item = -1;
+
+	Ref<InputEventKey> key = event;
+	if (key.is_valid() && type_ahead(key, current, &item)) {
+		// Keep the highlight if nothing matches.
+		if (item < 0)
+			item = current;
+	}
+	else if (event->is_action_pressed("ui_up", true)) {
+		item = std::max(0, current - 1);
+	}
+	else if (event->is_action_pressed("ui_down", true)) {
+		item = std::min(get_virtual_item_count() - 1, current + 1);
+	}
+	else if (event->is_action_pressed("ui_accept")) {
+		virtual_popup->hide();
+		if (current >= 0)
+			select_and_emit(current);
+
+		virtual_popup->set_input_as_handled();
+		return;
+	}
+	else {
+		return;
+	}
+
+	virtual_focused = item;
+	scroll_to_virtual_item(item);
+	update_virtual_rows();
+
+	virtual_popup->set_input_as_handled();
+}
 
 }
@@ -13,20 +13,94 @@
 #pragma once
 
 #include "helpers.hpp"
+#include "core/item_texts.hpp"
+#include "core/search_index.hpp"
 
 #include <godot_cpp/classes/input_event.hpp>
+#include <godot_cpp/classes/input_event_key.hpp>
 #include <godot_cpp/classes/option_button.hpp>
 
+#include <vector>
+
 namespace godot {
 
+class Button;
+class PopupPanel;
+class VScrollBar;
+
 class ScrollableOptionButton : public OptionButton {
 	GDCLASS(ScrollableOptionButton, OptionButton)
 
+public:
+	// Shows virtual_items in a popup that creates only the visible rows and
+	// reuses them while scrolling. Meant for thousands of items.
+	// The items of OptionButton aren't used, the selection is virtual_selected.
+	DECLARE_PROPERTY(bool, virtual_mode, false)
+	DECLARE_PROPERTY(int32_t, virtual_selected, -1)
+
+	// Extra items per wheel step for every step of a fast gesture. Useful for long lists.
+	DECLARE_PROPERTY(float, wheel_acceleration, 0)
+
+public:
+	void set_virtual_items(const PackedStringArray& p_virtual_items);
+	PackedStringArray get_virtual_items() const;
+
+	int32_t get_virtual_item_count() const;
+	String get_virtual_item_text(int32_t index) const;
+
 public:
 	virtual void _gui_input(const Ref<InputEvent>& event) override;
 
 protected:
+	void _notification(int p_what);
 	static void _bind_methods();
+
+private:
+	int32_t get_current_index() const;
+	int32_t get_current_count() const;
+	void select_and_emit(int32_t index);
+
+	// Wheel steps are accumulated and applied once per frame.
+	void add_wheel_steps(float steps);
+	void apply_wheel_steps();
+
+	// Typing jumps to the items that start with or contain the typed text.
+	// Returns true if the key is a typed character. item is -1 if nothing matches.
+	bool type_ahead(const Ref<InputEventKey>& key, int32_t current, int32_t* item);
+	void invalidate_search_index();
+	void on_popup_input(const Ref<InputEvent>& event);
+
+	void show_virtual_popup();
+	void create_virtual_popup();
+	Button* create_virtual_row();
+	void update_virtual_rows();
+	void on_virtual_rows_input(const Ref<InputEvent>& event);
+	void on_virtual_row_pressed(int32_t row);
+	void on_virtual_popup_input(const Ref<InputEvent>& event);
+	void scroll_to_virtual_item(int32_t item);
+
+private:
+	acrylic::ItemTexts virtual_texts;
+
+	float wheel_steps = 0;
+	// The sign of the last wheel event. 0 before the first one.
+	int8_t wheel_direction = 0;
+	int wheel_streak = 0;
+	uint64_t last_wheel_time = 0; // usec
+
+	// Built on the first typed character after the items have changed.
+	acrylic::SearchIndex search_index;
+	acrylic::Typeahead typeahead;
+
+	PopupPanel* virtual_popup = nullptr;
+	Control* virtual_rows_area = nullptr;
+	VScrollBar* virtual_scroll_bar = nullptr;
+	std::vector<Button*> virtual_rows;
+	// Item shown by each row, -1 if the row is hidden.
+	std::vector<int32_t> virtual_row_items;
+	float virtual_row_height = 0;
+	// Item highlighted by typing or arrows in the open popup, -1 if none.
+	int32_t virtual_focused = -1;
 };
 
 }
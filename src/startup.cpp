@@ -0,0 +1,195 @@
+/**************************************************************************/
+/*  startup.cpp                                                           */
+/*  Style applied to the main window before its first frame.              */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "startup.hpp"
+
+#include "helpers.hpp"
+#include "native_window.hpp"
+#include "core/style.hpp"
+
+#include <godot_cpp/classes/display_server.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+
+using namespace godot;
+
+namespace {
+	constexpr char PRINT_CATEGORY[] = "AcrylicWindow";
+
+	constexpr char ENABLED_SETTING[] = "acrylic_window/startup/enabled";
+	constexpr char PRESET_SETTING[] = "acrylic_window/startup/preset";
+	constexpr char BACKDROP_SETTING[] = "acrylic_window/startup/backdrop";
+	constexpr char CORNER_SETTING[] = "acrylic_window/startup/corner";
+	constexpr char ALWAYS_ON_TOP_SETTING[] = "acrylic_window/startup/always_on_top";
+	constexpr char BASE_COLOR_SETTING[] = "acrylic_window/startup/base_color";
+
+	// Same default as AcrylicWindow.
+	const Color DEFAULT_BASE_COLOR = Color(0.133, 0.145, 0.149, 0.741);
+
+	// Timestamps from monitor_now(). 0 means not happened yet.
+	int64_t init_time = 0;
+	int64_t styled_time = 0;
+	int64_t frame_time = 0;
+	bool early_style = false;
+
+	void add_setting(ProjectSettings* project_settings, const String& name, const Variant& default_value, PropertyHint hint = PROPERTY_HINT_NONE, const String& hint_string = "") {
+		if (!project_settings->has_setting(name))
+			project_settings->set_setting(name, default_value);
+
+		project_settings->set_initial_value(name, default_value);
+
+		Dictionary property_info;
+		property_info["name"] = name;
+		property_info["type"] = default_value.get_type();
+		property_info["hint"] = hint;
+		property_info["hint_string"] = hint_string;
+		project_settings->add_property_info(property_info);
+	}
+
+	void on_frame_post_draw() {
+		if (frame_time)
+			return;
+
+		frame_time = monitor_now();
+		print_debug("The first styled frame has been drawn in %.3f ms.", (frame_time - init_time) / 1e6);
+	}
+
+	// Reads the property from the preset or falls back to the setting.
+	Variant get_style_value(ProjectSettings* project_settings, const Ref<Resource>& preset, const char* property, const char* setting, const Variant& default_value) {
+		if (preset.is_valid()) {
+			Variant value = preset->get(property);
+			if (value.get_type() != Variant::NIL)
+				return value;
+		}
+
+		if (!setting)
+			return default_value;
+
+		return project_settings->get_setting(setting, default_value);
+	}
+
+	StartupStyle load_style(ProjectSettings* project_settings) {
+		Ref<Resource> preset;
+
+		String preset_path = project_settings->get_setting(PRESET_SETTING, String());
+		if (!preset_path.is_empty()) {
+			ResourceLoader* resource_loader = ResourceLoader::get_singleton();
+			if (resource_loader)
+				preset = resource_loader->load(preset_path);
+
+			if (preset.is_null())
+				print_error("Failed to load the startup preset %s. Using Project Settings.", preset_path.utf8().get_data());
+		}
+
+		StartupStyle style;
+		style.backdrop = static_cast<AcrylicWindow::Backdrop>(static_cast<int64_t>(
+			get_style_value(project_settings, preset, "backdrop", BACKDROP_SETTING, static_cast<int64_t>(style.backdrop))));
+		style.corner = static_cast<AcrylicWindow::Corner>(static_cast<int64_t>(
+			get_style_value(project_settings, preset, "corner", CORNER_SETTING, static_cast<int64_t>(style.corner))));
+		style.always_on_top = get_style_value(project_settings, preset, "always_on_top", ALWAYS_ON_TOP_SETTING, style.always_on_top);
+
+		Color base_color = get_style_value(project_settings, preset, "base_color", BASE_COLOR_SETTING, DEFAULT_BASE_COLOR);
+		bool auto_colors = get_style_value(project_settings, preset, "auto_colors", nullptr, true);
+		if (auto_colors) {
+			acrylic::StyleColors colors = acrylic::adjust_colors(to_rgba(base_color));
+			style.border_color = to_color(colors.border_color);
+			style.title_bar_color = to_color(colors.title_bar_color);
+			style.text_color = to_color(colors.text_color);
+			style.clear_color = to_color(colors.clear_color);
+		}
+		else {
+			style.border_color = get_style_value(project_settings, preset, "border_color", nullptr, style.border_color);
+			style.title_bar_color = get_style_value(project_settings, preset, "title_bar_color", nullptr, style.title_bar_color);
+			style.text_color = get_style_value(project_settings, preset, "text_color", nullptr, style.text_color);
+			style.clear_color = get_style_value(project_settings, preset, "clear_color", nullptr, style.clear_color);
+		}
+
+		return style;
+	}
+
+	void apply_startup_style(ProjectSettings* project_settings) {
+		// Never restyle the editor at startup.
+		if (is_editor())
+			return;
+
+		if (!static_cast<bool>(project_settings->get_setting(ENABLED_SETTING, false)))
+			return;
+
+		StartupStyle style = load_style(project_settings);
+		if (!NativeWindow::apply_startup_style(DisplayServer::MAIN_WINDOW_ID, style)) {
+			print_error("Failed to apply the startup style.");
+			return;
+		}
+
+		early_style = true;
+		startup_mark_styled();
+	}
+}
+
+namespace godot {
+
+void register_startup_settings() {
+	init_time = monitor_now();
+
+	ProjectSettings* project_settings = ProjectSettings::get_singleton();
+	if (!project_settings) {
+		print_error("Failed to get project settings.");
+		return;
+	}
+
+	StartupStyle style;
+	add_setting(project_settings, ENABLED_SETTING, false);
+	add_setting(project_settings, PRESET_SETTING, String(), PROPERTY_HINT_FILE, "*.tres,*.res");
+	add_setting(project_settings, BACKDROP_SETTING, static_cast<int64_t>(style.backdrop), PROPERTY_HINT_ENUM, "Solid,Transparent,Acrylic,Mica,Tabbed");
+	add_setting(project_settings, CORNER_SETTING, static_cast<int64_t>(style.corner), PROPERTY_HINT_ENUM, "Default,Don't Round,Round,Round Small");
+	add_setting(project_settings, ALWAYS_ON_TOP_SETTING, style.always_on_top);
+	add_setting(project_settings, BASE_COLOR_SETTING, DEFAULT_BASE_COLOR);
+
+	apply_startup_style(project_settings);
+}
+
+void unregister_startup_settings() {
+	RenderingServer* rendering_server = RenderingServer::get_singleton();
+	if (!rendering_server)
+		return;
+
+	Callable callable = callable_mp_static(&on_frame_post_draw);
+	if (rendering_server->is_connected("frame_post_draw", callable))
+		rendering_server->disconnect("frame_post_draw", callable);
+}
+
+void startup_mark_styled() {
+	if (styled_time)
+		return;
+
+	styled_time = monitor_now();
+
+	RenderingServer* rendering_server = RenderingServer::get_singleton();
+	if (!rendering_server) {
+		print_error("Failed to get rendering server.");
+		return;
+	}
+
+	rendering_server->connect("frame_post_draw", callable_mp_static(&on_frame_post_draw), Object::CONNECT_ONE_SHOT);
+}
+
+Dictionary get_startup_timings() {
+	Dictionary timings;
+	timings["init_to_styled_usec"] = styled_time ? (styled_time - init_time) / 1e3 : -1.0;
+	timings["init_to_first_styled_frame_usec"] = frame_time ? (frame_time - init_time) / 1e3 : -1.0;
+	timings["early_style"] = early_style;
+	return timings;
+}
+
+}
@@ -0,0 +1,49 @@
+/**************************************************************************/
+/*  startup.hpp                                                           */
+/*  Style applied to the main window before its first frame.              */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include "acrylic_window.hpp"
+
+#include <godot_cpp/variant/dictionary.hpp>
+
+namespace godot {
+
+// Same defaults as AcrylicWindow.
+struct StartupStyle {
+	bool always_on_top = true;
+	AcrylicWindow::Backdrop backdrop = AcrylicWindow::BACKDROP_ACRYLIC;
+	AcrylicWindow::Corner corner = AcrylicWindow::CORNER_DEFAULT;
+	Color border_color = Color(0, 0, 0);
+	Color title_bar_color = Color(0, 0, 0);
+	Color text_color = Color(1, 1, 1);
+	Color clear_color = Color(0, 0, 0);
+};
+
+// Adds Project Settings > Acrylic Window > Startup. If enabled, the style
+// is read from these settings or from the preset resource and applied to
+// the main window right away, before the first frame is presented.
+//
+// The preset can be any resource with the properties of AcrylicWindow
+// (backdrop, corner, always_on_top, auto_colors, base_color, ...).
+void register_startup_settings();
+void unregister_startup_settings();
+
+// The styled frame is the first frame presented after the style has been
+// applied either at startup or by AcrylicWindow when it's ready.
+void startup_mark_styled();
+
+// init_to_styled_usec, init_to_first_styled_frame_usec (-1 until known)
+// and early_style.
+Dictionary get_startup_timings();
+
+}
@@ -15,7 +15,7 @@
 #include "helpers.hpp"
 
 namespace {
-	const char PRINT_CATEGORY[] = "SwitchTween";
+	constexpr char PRINT_CATEGORY[] = "SwitchTween";
 }
 
 namespace godot {
@@ -38,6 +38,7 @@ void SwitchTween::set_on(const bool p_on) {
 		tween->kill();
 
 	tween = create_tween();
+	monitor_tween(tween.ptr());
 	on = p_on;
 }
 
@@ -0,0 +1,154 @@
+/**************************************************************************/
+/*  trace.cpp                                                             */
+/*  Scoped trace spans exported as Chrome trace JSON (Perfetto).          */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "trace.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace godot;
+
+namespace {
+	// Max spans per thread per trace. The rest are dropped.
+	constexpr uint32_t TRACE_CAPACITY = 1 << 16;
+
+	struct TraceEvent {
+		const char* name;
+		int64_t start;
+		int64_t duration;
+	};
+
+	// Only the owning thread writes to the buffer. It resets the buffer
+	// lazily when it notices that a new trace has been started.
+	struct TraceBuffer {
+		uint32_t thread_id = 0;
+		std::unique_ptr<TraceEvent[]> events;
+		std::atomic<uint32_t> count;
+		std::atomic<uint32_t> generation;
+	};
+
+	std::mutex buffers_mutex;
+	std::vector<std::unique_ptr<TraceBuffer>> buffers;
+
+	thread_local TraceBuffer* local_buffer = nullptr;
+
+	std::atomic<uint32_t> generation;
+	std::atomic<uint64_t> dropped;
+	int64_t origin = 0;
+
+	TraceBuffer* create_buffer() {
+		auto buffer = std::make_unique<TraceBuffer>();
+		buffer->events.reset(new TraceEvent[TRACE_CAPACITY]);
+		buffer->count.store(0, std::memory_order_relaxed);
+		buffer->generation.store(generation.load(std::memory_order_acquire), std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> guard(buffers_mutex);
+		buffer->thread_id = static_cast<uint32_t>(buffers.size() + 1);
+		buffers.push_back(std::move(buffer));
+
+		return buffers.back().get();
+	}
+}
+
+namespace godot {
+
+std::atomic<bool> trace_enabled;
+
+int64_t trace_now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void trace_record(const char* name, int64_t start, int64_t end) {
+	if (!trace_enabled.load(std::memory_order_relaxed))
+		return;
+
+	if (!local_buffer)
+		local_buffer = create_buffer();
+
+	TraceBuffer* buffer = local_buffer;
+
+	uint32_t current_generation = generation.load(std::memory_order_acquire);
+	if (buffer->generation.load(std::memory_order_relaxed) != current_generation) {
+		buffer->count.store(0, std::memory_order_relaxed);
+		buffer->generation.store(current_generation, std::memory_order_release);
+	}
+
+	uint32_t index = buffer->count.load(std::memory_order_relaxed);
+	if (index >= TRACE_CAPACITY) {
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	buffer->events[index] = { name, start, end - start };
+	buffer->count.store(index + 1, std::memory_order_release);
+}
+
+bool trace_start() {
+	if (trace_enabled.load(std::memory_order_relaxed))
+		return false;
+
+	origin = trace_now();
+	dropped.store(0, std::memory_order_relaxed);
+	generation.fetch_add(1, std::memory_order_acq_rel);
+	trace_enabled.store(true, std::memory_order_release);
+
+	return true;
+}
+
+bool trace_stop(const char* path) {
+	if (!trace_enabled.exchange(false, std::memory_order_acq_rel))
+		return false;
+
+	FILE* file = fopen(path, "wb");
+	if (!file)
+		return false;
+
+	uint32_t current_generation = generation.load(std::memory_order_acquire);
+	bool first = true;
+
+	fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+	std::lock_guard<std::mutex> guard(buffers_mutex);
+	for (const auto& buffer : buffers) {
+		if (buffer->generation.load(std::memory_order_acquire) != current_generation)
+			continue;
+
+		uint32_t count = buffer->count.load(std::memory_order_acquire);
+		if (!count)
+			continue;
+
+		fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}",
+			first ? "" : ",", buffer->thread_id, buffer->thread_id);
+		first = false;
+
+		for (uint32_t i = 0; i < count; i++) {
+			const TraceEvent& event = buffer->events[i];
+			fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"acrylic_window\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+				event.name, buffer->thread_id, (event.start - origin) / 1000.0, event.duration / 1000.0);
+		}
+	}
+
+	uint64_t dropped_count = dropped.load(std::memory_order_relaxed);
+	fprintf(file, "\n],\"otherData\":{\"dropped_events\":%llu}}\n", static_cast<unsigned long long>(dropped_count));
+
+	return fclose(file) == 0;
+}
+
+bool trace_is_running() {
+	return trace_enabled.load(std::memory_order_relaxed);
+}
+
+}
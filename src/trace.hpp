@@ -0,0 +1,68 @@
+/**************************************************************************/
+/*  trace.hpp                                                             */
+/*  Scoped trace spans exported as Chrome trace JSON (Perfetto).          */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// EXAMPLES
+// void AcrylicWindow::apply_style() {
+//     TRACE_SCOPE("AcrylicWindow::apply_style");
+//     ...
+// }
+//
+// Span names must be string literals because only the pointer is recorded.
+// When tracing is stopped a span costs one relaxed atomic load.
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+#define TRACE_SCOPE(name) \
+	::godot::TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+
+namespace godot {
+
+extern std::atomic<bool> trace_enabled;
+
+int64_t trace_now();
+void trace_record(const char* name, int64_t start, int64_t end);
+
+// Starts recording spans of all threads. Returns false if already started.
+bool trace_start();
+
+// Stops recording and writes Chrome trace JSON to the file at path.
+bool trace_stop(const char* path);
+
+bool trace_is_running();
+
+class TraceScope {
+public:
+	explicit TraceScope(const char* name)
+		: name(name)
+		, start(trace_enabled.load(std::memory_order_relaxed) ? trace_now() : 0)
+	{}
+
+	~TraceScope() {
+		if (start)
+			trace_record(name, start, trace_now());
+	}
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+	const char* name;
+	int64_t start;
+};
+
+}
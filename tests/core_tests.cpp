@@ -0,0 +1,871 @@
+/**************************************************************************/
+/*  core_tests.cpp                                                        */
+/*  Checks of the Godot-free core library.                                */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "core/border.hpp"
+#include "core/hit_test.hpp"
+#include "core/item_texts.hpp"
+#include "core/region.hpp"
+#include "core/right_click_drag.hpp"
+#include "core/screen_scale.hpp"
+#include "core/search_index.hpp"
+#include "core/style.hpp"
+#include "core/window_registry.hpp"
+#include "core/x11_hints.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+#include <thread>
+#include <vector>
+
+// Prints the failed checks and a summary:
+// core-tests: 42 checks, 0 failed
+//
+// Returns 1 if any check failed.
+//
+// Usage: core-tests
+
+#define CHECK(condition) check((condition), #condition, __FILE__, __LINE__)
+
+namespace {
+	int checks = 0;
+	int failures = 0;
+
+	void check(bool passed, const char* expression, const char* file, int line) {
+		checks++;
+		if (passed)
+			return;
+
+		failures++;
+		fprintf(stderr, "%s:%d: CHECK(%s) failed.\n", file, line, expression);
+	}
+
+	bool is_near(const acrylic::Rgba& a, const acrylic::Rgba& b) {
+		constexpr float epsilon = 1e-5f;
+		return std::fabs(a.r - b.r) < epsilon && std::fabs(a.g - b.g) < epsilon
+			&& std::fabs(a.b - b.b) < epsilon && std::fabs(a.a - b.a) < epsilon;
+	}
+
+	void test_adjust_colors() {
+		using namespace acrylic;
+
+		// An opaque base color keeps its borders.
+		Rgba dark(0.1f, 0.1f, 0.2f);
+		StyleColors colors = adjust_colors(dark);
+		CHECK(colors.border_color == dark);
+		CHECK(colors.title_bar_color == colors.border_color);
+		CHECK(colors.text_color == Rgba(1, 1, 1));
+		CHECK(is_near(colors.clear_color, Rgba(0.015f, 0.015f, 0.03f)));
+
+		// A light base color gets dark text.
+		Rgba light(0.9f, 0.9f, 0.9f);
+		CHECK(adjust_colors(light).text_color == Rgba(0, 0, 0));
+
+		// A transparent base color gets a gray border of its luminance,
+		// the tint is scaled with its alpha.
+		Rgba transparent(1, 1, 1, 0);
+		colors = adjust_colors(transparent);
+		CHECK(is_near(colors.border_color, Rgba(0.75f, 0.75f, 0.75f, 0.75f)));
+		CHECK(colors.clear_color.a == 0);
+	}
+
+	void test_get_window_border() {
+		using namespace acrylic;
+
+		Rect frame_rect = { -8, -8, 8, 8 };
+
+		// Only a fifth of the top is kept to hide the thick border.
+		Border border = get_window_border(frame_rect, false);
+		CHECK(border.top == -1);
+		CHECK(border.left == -8);
+		CHECK(border.right == 8);
+		CHECK(border.bottom == 8);
+
+		// The whole top is cut off the screen when maximized.
+		CHECK(get_window_border(frame_rect, true).top == -8);
+	}
+
+	void test_calculate_client_rect() {
+		using namespace acrylic;
+
+		Border border = get_window_border({ -8, -8, 8, 8 }, false);
+		const Rect window_rect = { 0, 0, 1920, 1080 };
+
+		Rect client_rect = window_rect;
+		CHECK(!calculate_client_rect(FRAME_DEFAULT, border, &client_rect));
+		CHECK(client_rect == window_rect);
+
+		client_rect = window_rect;
+		CHECK(calculate_client_rect(FRAME_BORDERLESS, border, &client_rect));
+		CHECK(client_rect == Rect({ 0, -2, 1920, 1080 }));
+
+		client_rect = window_rect;
+		CHECK(calculate_client_rect(FRAME_CUSTOM, border, &client_rect));
+		CHECK(client_rect == Rect({ 8, 1, 1912, 1072 }));
+	}
+
+	// AdjustWindowRectEx of an empty client rect at a DPI.
+	struct FrameRects {
+		int dpi;
+		acrylic::Rect frame_rect;
+		acrylic::Rect caption_rect;
+	};
+
+	const FrameRects FRAME_RECTS[] = {
+		{ 96, { -8, -8, 8, 8 }, { -8, -31, 8, 8 } },
+		{ 144, { -11, -11, 11, 11 }, { -11, -45, 11, 11 } },
+		{ 192, { -16, -16, 16, 16 }, { -16, -61, 16, 16 } }
+	};
+
+	void test_get_border_metrics() {
+		using namespace acrylic;
+
+		const Rect window_rect = { 100, 100, 1380, 820 };
+
+		for (const FrameRects& rects : FRAME_RECTS) {
+			for (bool maximized : { false, true }) {
+				BorderMetrics metrics = get_border_metrics(rects.frame_rect, rects.caption_rect, maximized);
+
+				int32_t top = maximized ? rects.frame_rect.top : rects.frame_rect.top / 5;
+				CHECK(metrics.border.top == top);
+				CHECK(metrics.border.left == rects.frame_rect.left);
+				CHECK(metrics.border.right == rects.frame_rect.right);
+				CHECK(metrics.border.bottom == rects.frame_rect.bottom);
+				CHECK(metrics.caption_top == rects.caption_rect.top);
+
+				for (Frame frame : { FRAME_DEFAULT, FRAME_BORDERLESS, FRAME_CUSTOM }) {
+					Rect client_rect = window_rect;
+					bool adjusted = calculate_client_rect(frame, metrics.border, &client_rect);
+
+					switch (frame) {
+					case FRAME_DEFAULT:
+						CHECK(!adjusted);
+						CHECK(client_rect == window_rect);
+						break;
+
+					case FRAME_BORDERLESS:
+						CHECK(adjusted);
+						CHECK(client_rect == Rect({ 100, 98, 1380, 820 }));
+						break;
+
+					case FRAME_CUSTOM:
+						CHECK(adjusted);
+						CHECK(client_rect == Rect({
+							window_rect.left - rects.frame_rect.left,
+							window_rect.top - top,
+							window_rect.right - rects.frame_rect.right,
+							window_rect.bottom - rects.frame_rect.bottom }));
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	// What wndproc does: query the rects only when the cache is invalid.
+	acrylic::BorderMetrics get_cached_metrics(acrylic::BorderMetricsCache& cache, const FrameRects& rects, bool maximized, int* queries) {
+		if (!cache.is_valid()) {
+			(*queries)++;
+			cache.store(rects.frame_rect, rects.caption_rect);
+		}
+
+		return cache.get(maximized);
+	}
+
+	void test_border_metrics_cache() {
+		using namespace acrylic;
+
+		const FrameRects& low_dpi = FRAME_RECTS[0];
+		const FrameRects& high_dpi = FRAME_RECTS[2];
+
+		BorderMetricsCache cache;
+		CHECK(!cache.is_valid());
+
+		int queries = 0;
+		BorderMetrics metrics = get_cached_metrics(cache, low_dpi, false, &queries);
+		CHECK(queries == 1);
+		CHECK(cache.is_valid());
+		CHECK(cache.get_frame_rect() == low_dpi.frame_rect);
+		CHECK(cache.get_caption_rect() == low_dpi.caption_rect);
+		CHECK(metrics.border == get_border_metrics(low_dpi.frame_rect, low_dpi.caption_rect, false).border);
+
+		// The maximized state is applied on every get without a query.
+		metrics = get_cached_metrics(cache, low_dpi, true, &queries);
+		CHECK(queries == 1);
+		CHECK(metrics.border.top == low_dpi.frame_rect.top);
+
+		// Until invalidated, the cache keeps the old rects even if the DPI changed.
+		metrics = get_cached_metrics(cache, high_dpi, false, &queries);
+		CHECK(queries == 1);
+		CHECK(metrics.caption_top == low_dpi.caption_rect.top);
+
+		cache.invalidate();
+		CHECK(!cache.is_valid());
+
+		metrics = get_cached_metrics(cache, high_dpi, false, &queries);
+		CHECK(queries == 2);
+		CHECK(metrics.border == get_border_metrics(high_dpi.frame_rect, high_dpi.caption_rect, false).border);
+		CHECK(metrics.caption_top == high_dpi.caption_rect.top);
+	}
+
+	void test_get_hit_zone() {
+		using namespace acrylic;
+
+		const int32_t caption_top = -31;
+
+		CHECK(get_hit_zone(-6, DEFAULT_HITTEST_BORDER, false, caption_top) == HIT_ZONE_RESIZE_TOP);
+		CHECK(get_hit_zone(-5, DEFAULT_HITTEST_BORDER, false, caption_top) == HIT_ZONE_DRAG);
+		CHECK(get_hit_zone(30, DEFAULT_HITTEST_BORDER, false, caption_top) == HIT_ZONE_DRAG);
+		CHECK(get_hit_zone(31, DEFAULT_HITTEST_BORDER, false, caption_top) == HIT_ZONE_CLIENT);
+
+		// The whole client area drags, but the resize border still wins.
+		CHECK(get_hit_zone(500, DEFAULT_HITTEST_BORDER, true, caption_top) == HIT_ZONE_DRAG);
+		CHECK(get_hit_zone(-6, DEFAULT_HITTEST_BORDER, true, caption_top) == HIT_ZONE_RESIZE_TOP);
+
+		// Without a caption nothing drags.
+		CHECK(get_hit_zone(0, DEFAULT_HITTEST_BORDER, false, INT32_MAX) == HIT_ZONE_CLIENT);
+	}
+
+	void test_right_click_drag() {
+		using namespace acrylic;
+
+		RightClickDrag drag;
+		Point delta;
+
+		CHECK(!drag.is_pressed());
+		CHECK(!drag.move({ 100, 100 }, &delta));
+
+		drag.press({ 0, 0 });
+		CHECK(drag.is_pressed());
+		CHECK(!drag.is_dragging());
+
+		// Within the threshold a right click still opens context menus.
+		CHECK(!drag.move({ 5, 5 }, &delta));
+		CHECK(!drag.move({ 10, 3 }, &delta));
+		CHECK(!drag.is_dragging());
+
+		// The travel adds up until it passes the threshold.
+		CHECK(drag.move({ 11, 3 }, &delta));
+		CHECK(delta == Point({ 1, 0 }));
+		CHECK(drag.is_dragging());
+
+		// Once dragging, every move moves the window.
+		CHECK(drag.move({ 11, 4 }, &delta));
+		CHECK(delta == Point({ 0, 1 }));
+
+		drag.release();
+		CHECK(!drag.is_pressed());
+		CHECK(!drag.is_dragging());
+		CHECK(!drag.move({ 50, 50 }, &delta));
+
+		// A new press starts counting the travel from zero.
+		drag.press({ 50, 50 });
+		CHECK(!drag.move({ 55, 50 }, &delta));
+		CHECK(!drag.is_dragging());
+	}
+
+	void test_dwm_mappings() {
+		using namespace acrylic;
+
+		// DWM_SYSTEMBACKDROP_TYPE
+		CHECK(get_dwm_backdrop_type(BACKDROP_SOLID) == 0);
+		CHECK(get_dwm_backdrop_type(BACKDROP_TRANSPARENT) == 1);
+		CHECK(get_dwm_backdrop_type(BACKDROP_MICA) == 2);
+		CHECK(get_dwm_backdrop_type(BACKDROP_ACRYLIC) == 3);
+		CHECK(get_dwm_backdrop_type(BACKDROP_TABBED) == 4);
+
+		// DWM_WINDOW_CORNER_PREFERENCE
+		CHECK(get_dwm_corner_preference(CORNER_DEFAULT) == 0);
+		CHECK(get_dwm_corner_preference(CORNER_DONT_ROUND) == 1);
+		CHECK(get_dwm_corner_preference(CORNER_ROUND) == 2);
+		CHECK(get_dwm_corner_preference(CORNER_ROUND_SMALL) == 3);
+	}
+
+	void test_is_draggable() {
+		using namespace acrylic;
+
+		HitTestSnapshot snapshot;
+		snapshot.blocking_region = { Rect{ 10, 10, 20, 20 } };
+
+		// Nothing is published yet.
+		CHECK(!is_draggable(snapshot, { 0, 0 }));
+
+		snapshot.generation = 1;
+		CHECK(is_draggable(snapshot, { 0, 0 }));
+		CHECK(is_draggable(snapshot, { 20, 15 }));
+		CHECK(!is_draggable(snapshot, { 10, 10 }));
+		CHECK(!is_draggable(snapshot, { 19, 19 }));
+
+		// A click outside the popup closes it instead.
+		snapshot.has_popup = true;
+		CHECK(!is_draggable(snapshot, { 0, 0 }));
+	}
+
+	// Snapshot n has n % 64 + 1 rects at (n, n) and has_popup and drag_by_content
+	// of its parity, so a torn snapshot disagrees with its generation.
+	void write_snapshot(acrylic::HitTestBuffer& buffer, int32_t n) {
+		acrylic::HitTestSnapshot& snapshot = buffer.begin_write();
+		snapshot.blocking_region.assign(static_cast<size_t>(n % 64 + 1), acrylic::Rect{ n, n, n + 1, n + 1 });
+		snapshot.has_popup = n % 2 != 0;
+		snapshot.drag_by_content = n % 2 != 0;
+		buffer.publish();
+	}
+
+	bool is_whole(const acrylic::HitTestSnapshot& snapshot) {
+		if (snapshot.generation == 0)
+			return snapshot.blocking_region.empty();
+
+		int32_t n = static_cast<int32_t>(snapshot.generation);
+		if (snapshot.blocking_region.size() != static_cast<size_t>(n % 64 + 1))
+			return false;
+
+		for (const acrylic::Rect& rect : snapshot.blocking_region) {
+			if (!(rect == acrylic::Rect{ n, n, n + 1, n + 1 }))
+				return false;
+		}
+
+		return snapshot.has_popup == (n % 2 != 0) && snapshot.drag_by_content == (n % 2 != 0);
+	}
+
+	void test_hit_test_buffer() {
+		constexpr int32_t WRITES = 5000;
+		constexpr int READERS = 3;
+
+		acrylic::HitTestBuffer buffer;
+		std::atomic<bool> done{ false };
+		std::atomic<int> torn{ 0 };
+		std::atomic<int> backwards{ 0 };
+
+		std::vector<std::thread> readers;
+		for (int i = 0; i < READERS; i++) {
+			readers.emplace_back([&] {
+				uint64_t last = 0;
+				while (!done.load()) {
+					buffer.read([&](const acrylic::HitTestSnapshot& snapshot) {
+						// Let the writer run while the snapshot is held. It must not change.
+						uint64_t generation = snapshot.generation;
+						bool whole = is_whole(snapshot);
+						std::this_thread::yield();
+
+						if (!whole || !is_whole(snapshot) || snapshot.generation != generation)
+							torn++;
+						if (generation < last)
+							backwards++;
+						last = generation;
+					});
+				}
+			});
+		}
+
+		// Snapshot n gets generation n.
+		for (int32_t n = 1; n <= WRITES; n++)
+			write_snapshot(buffer, n);
+
+		done = true;
+		for (std::thread& reader : readers)
+			reader.join();
+
+		CHECK(torn == 0);
+		CHECK(backwards == 0);
+		buffer.read([](const acrylic::HitTestSnapshot& snapshot) {
+			CHECK(snapshot.generation == WRITES);
+		});
+	}
+
+	void test_hit_test_buffer_waits_for_readers() {
+		acrylic::HitTestBuffer buffer;
+		write_snapshot(buffer, 1);
+
+		// The reader holds snapshot 1 until released.
+		std::atomic<bool> reading{ false };
+		std::atomic<bool> release{ false };
+		std::thread reader([&] {
+			buffer.read([&](const acrylic::HitTestSnapshot&) {
+				reading = true;
+				while (!release.load())
+					std::this_thread::yield();
+			});
+		});
+
+		while (!reading.load())
+			std::this_thread::yield();
+
+		// The other buffer is free.
+		write_snapshot(buffer, 2);
+
+		// The next write reuses the buffer of snapshot 1.
+		std::atomic<bool> written{ false };
+		std::thread writer([&] {
+			buffer.begin_write();
+			written = true;
+		});
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		CHECK(!written.load());
+
+		release = true;
+		reader.join();
+		writer.join();
+		CHECK(written.load());
+	}
+
+	// A 30x30 square with a 10x10 hole in the middle, as merge_rects returns it.
+	const std::vector<acrylic::Rect> RING = {
+		{ 0, 0, 30, 10 },
+		{ 0, 10, 10, 20 }, { 20, 10, 30, 20 },
+		{ 0, 20, 30, 30 }
+	};
+
+	void test_merge_rects() {
+		using namespace acrylic;
+
+		CHECK(merge_rects({}).empty());
+		CHECK(merge_rects({ { 5, 5, 5, 10 }, { 0, 3, 10, 3 } }).empty());
+
+		// Overlapping rects are split into bands.
+		CHECK(merge_rects({ { 0, 0, 10, 10 }, { 5, 5, 15, 15 } }) == std::vector<Rect>({
+			{ 0, 0, 10, 5 }, { 0, 5, 15, 10 }, { 5, 10, 15, 15 } }));
+
+		// Adjacent bands with the same spans merge, and so do touching spans.
+		CHECK(merge_rects({ { 0, 0, 10, 5 }, { 0, 5, 10, 10 } }) == std::vector<Rect>({ { 0, 0, 10, 10 } }));
+		CHECK(merge_rects({ { 0, 0, 5, 10 }, { 5, 0, 10, 10 } }) == std::vector<Rect>({ { 0, 0, 10, 10 } }));
+		CHECK(merge_rects({ { 0, 0, 5, 5 }, { 5, 0, 10, 5 }, { 0, 5, 10, 10 } }) == std::vector<Rect>({ { 0, 0, 10, 10 } }));
+
+		// Rects touching only at a corner stay apart.
+		CHECK(merge_rects({ { 5, 5, 10, 10 }, { 0, 0, 5, 5 } }) == std::vector<Rect>({ { 0, 0, 5, 5 }, { 5, 5, 10, 10 } }));
+
+		// A hole survives, and the same area gives the same list in any order.
+		CHECK(merge_rects({ { 0, 20, 30, 30 }, { 20, 0, 30, 30 }, { 0, 0, 10, 30 }, { 0, 0, 30, 10 } }) == RING);
+		CHECK(merge_rects(RING) == RING);
+	}
+
+	void test_subtract_rects() {
+		using namespace acrylic;
+
+		const Rect bounds = { 0, 0, 30, 30 };
+		CHECK(subtract_rects(bounds, {}) == std::vector<Rect>({ bounds }));
+		CHECK(subtract_rects(bounds, { { -5, -5, 35, 35 } }).empty());
+		CHECK(subtract_rects(bounds, { { 10, 10, 20, 20 } }) == RING);
+
+		// Only the part inside the bounds is subtracted.
+		CHECK(subtract_rects(bounds, { { 20, -10, 40, 10 } }) == std::vector<Rect>({ { 0, 0, 20, 10 }, { 0, 10, 30, 30 } }));
+
+		// The hole and the rest cover the bounds.
+		std::vector<Rect> rest = subtract_rects(bounds, { { 10, 10, 20, 20 }, { 0, 0, 5, 5 } });
+		rest.push_back({ 10, 10, 20, 20 });
+		rest.push_back({ 0, 0, 5, 5 });
+		CHECK(merge_rects(rest) == std::vector<Rect>({ bounds }));
+	}
+
+	void test_contains() {
+		using namespace acrylic;
+
+		CHECK(!contains({}, { 0, 0 }));
+
+		CHECK(contains(RING, { 0, 0 }));
+		CHECK(contains(RING, { 9, 9 }));
+		CHECK(contains(RING, { 29, 29 }));
+		CHECK(contains(RING, { 25, 15 }));
+		CHECK(!contains(RING, { 10, 10 }));
+		CHECK(!contains(RING, { 15, 15 }));
+		CHECK(!contains(RING, { 19, 19 }));
+		CHECK(!contains(RING, { 30, 5 }));
+		CHECK(!contains(RING, { 5, 30 }));
+		CHECK(!contains(RING, { -1, 0 }));
+
+		// Right and bottom edges are outside, so corners belong to one rect.
+		const std::vector<Rect> corners = merge_rects({ { 0, 0, 5, 5 }, { 5, 5, 10, 10 } });
+		CHECK(contains(corners, { 4, 4 }));
+		CHECK(contains(corners, { 5, 5 }));
+		CHECK(!contains(corners, { 5, 4 }));
+		CHECK(!contains(corners, { 4, 5 }));
+	}
+
+	// Twice the signed area. Positive for clockwise with y pointing down.
+	int64_t get_doubled_area(const std::vector<acrylic::Point>& polygon) {
+		int64_t area = 0;
+		for (size_t i = 0; i < polygon.size(); i++) {
+			const acrylic::Point& a = polygon[i];
+			const acrylic::Point& b = polygon[(i + 1) % polygon.size()];
+			area += int64_t(a.x) * b.y - int64_t(b.x) * a.y;
+		}
+
+		return area;
+	}
+
+	// Even-odd rule at the center of a pixel, which is never on an edge
+	// with integer corners, except for bridges that are walked twice.
+	bool is_inside_even_odd(const std::vector<acrylic::Point>& polygon, int32_t x, int32_t y) {
+		double px = x + 0.5;
+		double py = y + 0.5;
+		bool inside = false;
+		for (size_t i = 0; i < polygon.size(); i++) {
+			const acrylic::Point& a = polygon[i];
+			const acrylic::Point& b = polygon[(i + 1) % polygon.size()];
+			if ((a.y > py) == (b.y > py))
+				continue;
+
+			double cross_x = a.x + (py - a.y) * (b.x - a.x) / (b.y - a.y);
+			if (px < cross_x)
+				inside = !inside;
+		}
+
+		return inside;
+	}
+
+	// Every pixel around the region is covered by the joined polygon
+	// under the even-odd rule exactly when the region contains it.
+	bool covers_same_pixels(const std::vector<acrylic::Rect>& region) {
+		std::vector<acrylic::Point> polygon = acrylic::join_outlines(acrylic::get_outlines(region));
+		for (int32_t y = -2; y < 34; y++) {
+			for (int32_t x = -2; x < 34; x++) {
+				if (is_inside_even_odd(polygon, x, y) != acrylic::contains(region, { x, y }))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	void test_get_outlines() {
+		using namespace acrylic;
+
+		CHECK(get_outlines({}).empty());
+
+		std::vector<std::vector<Point>> outlines = get_outlines({ { 0, 0, 10, 10 } });
+		CHECK(outlines.size() == 1);
+		CHECK(outlines[0].size() == 4);
+		CHECK(get_doubled_area(outlines[0]) == 2 * 100);
+
+		// Only the corners are kept, the band split at y = 5 isn't.
+		outlines = get_outlines(merge_rects({ { 0, 0, 10, 5 }, { 0, 5, 5, 10 } }));
+		CHECK(outlines.size() == 1);
+		CHECK(outlines[0].size() == 6);
+		CHECK(get_doubled_area(outlines[0]) == 2 * 75);
+
+		// The outer boundary goes clockwise, the hole counterclockwise.
+		outlines = get_outlines(RING);
+		CHECK(outlines.size() == 2);
+		int64_t outer = 0;
+		int64_t hole = 0;
+		for (const std::vector<Point>& outline : outlines) {
+			CHECK(outline.size() == 4);
+			int64_t area = get_doubled_area(outline);
+			if (area > 0)
+				outer = area;
+			else
+				hole = area;
+		}
+
+		CHECK(outer == 2 * 900);
+		CHECK(hole == -2 * 100);
+
+		// Rects touching at a corner keep their own area either way round.
+		int64_t total = 0;
+		for (const std::vector<Point>& outline : get_outlines(merge_rects({ { 0, 0, 5, 5 }, { 5, 5, 10, 10 } })))
+			total += get_doubled_area(outline);
+		CHECK(total == 2 * 50);
+	}
+
+	void test_join_outlines() {
+		using namespace acrylic;
+
+		CHECK(join_outlines({}).empty());
+		CHECK(join_outlines({ {}, {} }).empty());
+
+		// One outline is closed back to its first point.
+		std::vector<Point> polygon = join_outlines(get_outlines({ { 0, 0, 10, 10 } }));
+		CHECK(polygon.size() == 5);
+		CHECK(polygon.front() == polygon.back());
+
+		CHECK(covers_same_pixels({ { 0, 0, 10, 10 } }));
+		CHECK(covers_same_pixels(RING));
+		CHECK(covers_same_pixels(merge_rects({ { 0, 0, 5, 5 }, { 5, 5, 10, 10 } })));
+		CHECK(covers_same_pixels(merge_rects({ { 0, 0, 10, 5 }, { 0, 5, 5, 10 } })));
+		CHECK(covers_same_pixels(merge_rects({ { 0, 0, 4, 4 }, { 20, 0, 30, 8 }, { 8, 20, 12, 30 } })));
+
+		// A frame with an island in its hole, and a hole in the island.
+		std::vector<Rect> nested = subtract_rects({ 0, 0, 32, 32 }, { { 4, 4, 28, 28 } });
+		for (const Rect& rect : subtract_rects({ 8, 8, 24, 24 }, { { 12, 12, 20, 20 } }))
+			nested.push_back(rect);
+		nested = merge_rects(nested);
+		CHECK(get_outlines(nested).size() == 4);
+		CHECK(covers_same_pixels(nested));
+	}
+
+	void test_get_outlines_malformed() {
+		using namespace acrylic;
+
+		// Overlapping and unsorted, as merge_rects never returns. The edges
+		// don't close up and tracing them used to run past the end.
+		const std::vector<Rect> rects = { { 5, 0, 15, 15 }, { 10, 5, 15, 10 }, { 5, 5, 15, 10 }, { 10, 10, 20, 20 } };
+		CHECK(get_outlines(rects).empty());
+		CHECK(!get_outlines(merge_rects(rects)).empty());
+	}
+
+	void test_item_texts() {
+		using namespace acrylic;
+
+		ItemTexts texts;
+		texts.reserve(4, 16);
+		CHECK(texts.size() == 0);
+
+		// Empty texts and multibyte characters keep their bytes.
+		texts.add("Apple");
+		texts.add("");
+		texts.add("\xD0\xAF\xD0\xB1\xD0\xBB\xD0\xBE\xD0\xBA\xD0\xBE");
+		texts.add("Banana");
+
+		CHECK(texts.size() == 4);
+		CHECK(texts.get(0) == "Apple");
+		CHECK(texts.get(1).empty());
+		CHECK(texts.get(2).size() == 12);
+		CHECK(texts.get(3) == "Banana");
+		CHECK(texts.get_memory_usage() >= 23 + 4 * sizeof(uint32_t));
+
+		texts.clear();
+		CHECK(texts.size() == 0);
+
+		texts.add("Cherry");
+		CHECK(texts.size() == 1);
+		CHECK(texts.get(0) == "Cherry");
+	}
+
+	// Sorted by folded text: "", apple, apricot, banana, band, bandana, blueberry, cherry.
+	acrylic::ItemTexts make_fruit_texts() {
+		acrylic::ItemTexts texts;
+		for (const char* text : { "Cherry", "banana", "Apple", "Bandana", "apricot", "band", "Blueberry", "" })
+			texts.add(text);
+
+		return texts;
+	}
+
+	void test_search_index() {
+		using namespace acrylic;
+
+		CHECK(SearchIndex::fold("BanDana 42") == "bandana 42");
+
+		SearchIndex index;
+		CHECK(!index.is_built());
+
+		index.build(make_fruit_texts());
+		CHECK(index.is_built());
+		CHECK(index.size() == 8);
+		CHECK(index.get_sorted_item(0) == 7);
+		CHECK(index.get_sorted_item(3) == 1);
+		CHECK(index.get_sorted_position(0) == 7);
+
+		PrefixRange range = index.find_prefix("B");
+		CHECK(range.first == 3 && range.last == 7);
+
+		// Refining narrows the range of the shorter prefix.
+		range = index.refine_prefix(range, "baN");
+		CHECK(range.first == 3 && range.last == 6);
+		range = index.refine_prefix(range, "band");
+		CHECK(range.first == 4 && range.last == 6);
+		CHECK(index.refine_prefix(range, "bandx").is_empty());
+		CHECK(index.find_prefix("z").is_empty());
+
+		// Short queries scan the items, longer ones go through the trigrams.
+		// Both append in item order.
+		std::vector<uint32_t> matches = { 100 };
+		index.find_substring("AN", &matches);
+		CHECK((matches == std::vector<uint32_t>{ 100, 1, 3, 5 }));
+
+		matches.clear();
+		index.find_substring("ana", &matches);
+		CHECK((matches == std::vector<uint32_t>{ 1, 3 }));
+
+		matches.clear();
+		index.find_substring("eRr", &matches);
+		CHECK((matches == std::vector<uint32_t>{ 0, 6 }));
+
+		// Every trigram is there, but not in this order.
+		matches.clear();
+		index.find_substring("ananan", &matches);
+		CHECK(matches.empty());
+
+		index.find_substring("xyz", &matches);
+		CHECK(matches.empty());
+	}
+
+	void test_typeahead() {
+		using namespace acrylic;
+
+		SearchIndex index;
+		index.build(make_fruit_texts());
+
+		// Any time after the initial one is a new search.
+		uint64_t now = 10 * Typeahead::TIMEOUT;
+
+		// Refining stays on the selected item while it still matches.
+		Typeahead typeahead;
+		CHECK(typeahead.type(index, "B", now, -1) == 1);
+		CHECK(typeahead.type(index, "a", now + 100, 1) == 1);
+		CHECK(typeahead.type(index, "n", now + 200, 1) == 1);
+		CHECK(typeahead.type(index, "d", now + 300, 1) == 5);
+		CHECK(typeahead.type(index, "a", now + 400, 5) == 3);
+		CHECK(typeahead.get_query() == "banda");
+		CHECK(typeahead.type(index, "z", now + 500, 3) == -1);
+
+		// The first character again cycles in text order and wraps.
+		typeahead.reset();
+		CHECK(typeahead.get_query().empty());
+		CHECK(typeahead.type(index, "b", now, -1) == 1);
+		CHECK(typeahead.type(index, "b", now + 100, 1) == 5);
+		CHECK(typeahead.type(index, "B", now + 200, 5) == 3);
+		CHECK(typeahead.type(index, "b", now + 300, 3) == 6);
+		CHECK(typeahead.type(index, "b", now + 400, 6) == 1);
+		CHECK(typeahead.get_query() == "b");
+
+		// Without a prefix match 3 characters fall back to substrings,
+		// which start at the selected item and wrap.
+		typeahead.reset();
+		CHECK(typeahead.type(index, "e", now, -1) == -1);
+		CHECK(typeahead.type(index, "r", now + 100, -1) == -1);
+		CHECK(typeahead.type(index, "r", now + 200, -1) == 0);
+		CHECK(typeahead.type(index, "y", now + 300, 3) == 6);
+		CHECK(typeahead.type(index, "!", now + 400, 6) == -1);
+
+		typeahead.reset();
+		CHECK(typeahead.type(index, "E", now, 7) == -1);
+		CHECK(typeahead.type(index, "R", now + 100, 7) == -1);
+		CHECK(typeahead.type(index, "R", now + 200, 7) == 0);
+
+		// A character at the timeout still refines, one after it starts over.
+		typeahead.reset();
+		CHECK(typeahead.type(index, "b", now, -1) == 1);
+		CHECK(typeahead.type(index, "a", now + Typeahead::TIMEOUT, 1) == 1);
+		CHECK(typeahead.get_query() == "ba");
+		CHECK(typeahead.type(index, "a", now + 2 * Typeahead::TIMEOUT + 1, 1) == 2);
+		CHECK(typeahead.get_query() == "a");
+
+		// After the items change the index is built again from the new texts.
+		index.clear();
+		CHECK(!index.is_built());
+		CHECK(index.size() == 0);
+
+		ItemTexts texts;
+		texts.add("Zucchini");
+		texts.add("banjo");
+		index.build(texts);
+		typeahead.reset();
+
+		CHECK(index.size() == 2);
+		CHECK(index.find_prefix("band").is_empty());
+		CHECK(typeahead.type(index, "b", now, 0) == 1);
+		CHECK(typeahead.type(index, "a", now + 100, 1) == 1);
+		CHECK(typeahead.type(index, "n", now + 200, 1) == 1);
+		CHECK(typeahead.type(index, "d", now + 300, 1) == -1);
+	}
+
+	void test_get_dpi_scale() {
+		using namespace acrylic;
+
+		CHECK(get_dpi_scale(0) == 1);
+		CHECK(get_dpi_scale(-1) == 1);
+
+		// Physical DPI of common desktop monitors stays at 100%.
+		CHECK(get_dpi_scale(72) == 1);
+		CHECK(get_dpi_scale(92) == 1);
+		CHECK(get_dpi_scale(96) == 1);
+		CHECK(get_dpi_scale(110) == 1);
+		CHECK(get_dpi_scale(115) == 1);
+
+		// The Windows steps and DPI close below them.
+		CHECK(get_dpi_scale(116) == 1.25f);
+		CHECK(get_dpi_scale(120) == 1.25f);
+		CHECK(get_dpi_scale(139) == 1.25f);
+		CHECK(get_dpi_scale(144) == 1.5f);
+		CHECK(get_dpi_scale(168) == 1.75f);
+		CHECK(get_dpi_scale(192) == 2);
+		CHECK(get_dpi_scale(288) == 3);
+	}
+
+	void test_x11_property_batch() {
+		using namespace acrylic;
+
+		X11PropertyBatch batch;
+		CHECK(batch.set_frame(FRAME_CUSTOM));
+		CHECK(batch.set_above(true));
+		CHECK(batch.take_dirty() == (X11_PROPERTY_MOTIF_HINTS | X11_PROPERTY_STATE_ABOVE));
+
+		// Nothing to write until a value changes.
+		CHECK(!batch.set_frame(FRAME_CUSTOM));
+		CHECK(batch.get_dirty() == 0);
+
+		// Setting a value back before the flush undoes the change.
+		CHECK(batch.set_above(false));
+		CHECK(!batch.set_above(true));
+		CHECK(batch.get_dirty() == 0);
+
+		// Invalidation rewrites only the properties that have a value.
+		batch.invalidate();
+		CHECK(batch.get_dirty() == (X11_PROPERTY_MOTIF_HINTS | X11_PROPERTY_STATE_ABOVE));
+		CHECK(batch.take_dirty() == (X11_PROPERTY_MOTIF_HINTS | X11_PROPERTY_STATE_ABOVE));
+		CHECK(batch.get_dirty() == 0);
+	}
+
+	void test_window_registry() {
+		acrylic::WindowRegistry<int> registry;
+		CHECK(registry.insert(1, 10) != nullptr);
+		CHECK(registry.insert(2, 20) != nullptr);
+		CHECK(registry.insert(1, 30) == nullptr);
+
+		uint64_t keys = 0;
+		int values = 0;
+		registry.for_each([&](uint64_t key, int& value) {
+			keys += key;
+			values += value;
+			value++;
+		});
+
+		CHECK(keys == 3);
+		CHECK(values == 30);
+		CHECK(*registry.find(1) == 11);
+		CHECK(registry.erase(1));
+		CHECK(registry.find(1) == nullptr);
+		CHECK(registry.size() == 1);
+	}
+}
+
+int main() {
+	test_adjust_colors();
+	test_get_window_border();
+	test_calculate_client_rect();
+	test_get_border_metrics();
+	test_border_metrics_cache();
+	test_get_hit_zone();
+	test_right_click_drag();
+	test_dwm_mappings();
+	test_is_draggable();
+	test_hit_test_buffer();
+	test_hit_test_buffer_waits_for_readers();
+	test_merge_rects();
+	test_subtract_rects();
+	test_contains();
+	test_get_outlines();
+	test_join_outlines();
+	test_get_outlines_malformed();
+	test_item_texts();
+	test_search_index();
+	test_typeahead();
+	test_get_dpi_scale();
+	test_x11_property_batch();
+	test_window_registry();
+
+	printf("core-tests: %d checks, %d failed\n", checks, failures);
+
+	return failures ? 1 : 0;
+}
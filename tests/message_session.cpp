@@ -0,0 +1,224 @@
+/**************************************************************************/
+/*  message_session.cpp                                                   */
+/*  Writes a synthetic recording for message-replay.                      */
+/**************************************************************************/
+/*  MIT License                                                           */
+/*                                                                        */
+/*  Alexander Vishnevsky (Sly)                                            */
+/*  Check more on GitHub: https://github.com/slyisdreaming                */
+/*  Hug me: https://boosty.to/slyisdreaming                               */
+/*                                                                        */
+/**************************************************************************/
+
+#include "core/hit_test.hpp"
+#include "core/message.hpp"
+#include "core/message_log.hpp"
+
+#include <cstdio>
+#include <initializer_list>
+
+// Writes a recording of a made-up session in the format of
+// AcrylicWindow.start_message_recording:
+// - hit tests over the resize border, the caption, a control that stops
+//   the mouse and the content, with and without drag_by_content;
+// - hit tests while a popup is open;
+// - right click drags started in the client and in the non-client area;
+// - WM_NCCALCSIZE of every frame, restored and maximized;
+// - activation changes and the fullscreen keys;
+// - a second window without frame rects.
+// The recorded results are what acrylic::handle_message returns now.
+//
+// tests/data/session.awml was written by this tool, so replaying it checks
+// the handlers against the results they had then. Regenerate it only when
+// a handler is meant to change.
+//
+// Usage: message-session <recording>
+
+namespace {
+	// The frame and caption rects of a window at 96 DPI, see get_border_metrics.
+	constexpr acrylic::Rect FRAME_RECT = { -8, -8, 8, 8 };
+	constexpr acrylic::Rect CAPTION_RECT = { -8, -31, 8, 8 };
+
+	// Values of the native constants.
+	constexpr int32_t HIT_TEST_LEFT = 10;
+	constexpr uint64_t KEY_A = 0x41;
+	constexpr uint64_t KEY_ENTER = 0x0D;
+	constexpr uint64_t KEY_F11 = 0x7A;
+	constexpr int64_t KEY_FLAG_ALT = 1 << 29;
+
+	// MAKELPARAM.
+	int64_t make_lparam(int32_t x, int32_t y) {
+		return static_cast<int64_t>(static_cast<uint16_t>(x)) | (static_cast<int64_t>(static_cast<uint16_t>(y)) << 16);
+	}
+
+	// One window of the session with the state its window procedure would keep.
+	struct Window {
+		acrylic::MessageRecorder* recorder = nullptr;
+		uint64_t key = 0;
+		acrylic::MessageState state;
+		acrylic::Frame frame = acrylic::FRAME_CUSTOM;
+		acrylic::HitTestSnapshot snapshot;
+		acrylic::MessageGeometry geometry;
+
+		void send(uint32_t id, uint64_t wparam, int64_t lparam) {
+			acrylic::Message message;
+			message.id = id;
+			message.wparam = wparam;
+			message.lparam = lparam;
+
+			acrylic::MessageResult result = acrylic::handle_message(state, frame, snapshot, geometry, message);
+			recorder->record(key, frame, snapshot, geometry, message, result);
+		}
+
+		// Takes client coordinates, the message has screen ones.
+		void hit_test(int32_t x, int32_t y) {
+			send(acrylic::MESSAGE_NCHITTEST, 0, make_lparam(geometry.client_origin.x + x, geometry.client_origin.y + y));
+		}
+
+		void publish() {
+			snapshot.generation++;
+		}
+	};
+
+	// Crosses the resize border, the caption, the button and the content.
+	void record_hit_tests(Window& window) {
+		for (int32_t y = -4; y <= 80; y += 6) {
+			for (int32_t x : { 10, 50, 400 })
+				window.hit_test(x, y);
+		}
+	}
+
+	void record_right_click_drag(Window& window, bool non_client) {
+		using namespace acrylic;
+
+		const Point press = { 400, non_client ? 10 : 300 };
+		const Point origin = window.geometry.client_origin;
+		if (non_client)
+			window.send(MESSAGE_NCRBUTTONDOWN, HIT_TEST_CAPTION, make_lparam(origin.x + press.x, origin.y + press.y));
+		else
+			window.send(MESSAGE_RBUTTONDOWN, 0, make_lparam(press.x, press.y));
+
+		// Below the drag threshold first, then dragging.
+		window.geometry.right_button_down = true;
+		for (int32_t step = 1; step <= 8; step++)
+			window.hit_test(press.x + step * 3, press.y + step * 2);
+
+		window.geometry.right_button_down = false;
+		window.send(non_client ? MESSAGE_NCRBUTTONUP : MESSAGE_RBUTTONUP, 0, make_lparam(press.x, press.y));
+		window.hit_test(press.x, press.y);
+	}
+
+	void record_nccalcsize(Window& window) {
+		using namespace acrylic;
+
+		const Frame frame = window.frame;
+		for (Frame recorded_frame : { FRAME_DEFAULT, FRAME_BORDERLESS, FRAME_CUSTOM }) {
+			window.frame = recorded_frame;
+			for (bool maximized : { false, true }) {
+				window.geometry.maximized = maximized;
+				window.send(MESSAGE_NCCALCSIZE, 1, 0);
+				window.send(MESSAGE_NCCALCSIZE, 0, 0);
+			}
+		}
+
+		window.geometry.maximized = false;
+		window.frame = frame;
+	}
+
+	void record_keys(Window& window) {
+		using namespace acrylic;
+
+		window.send(MESSAGE_NCACTIVATE, 0, 0);
+		window.send(MESSAGE_NCACTIVATE, 1, 0);
+		window.send(MESSAGE_KEYUP, KEY_F11, 0);
+		window.send(MESSAGE_KEYUP, KEY_A, 0);
+		window.send(MESSAGE_SYSKEYUP, KEY_ENTER, KEY_FLAG_ALT);
+		window.send(MESSAGE_SYSKEYUP, KEY_ENTER, 0);
+	}
+
+	void record_session(acrylic::MessageRecorder& recorder) {
+		using namespace acrylic;
+
+		Window main;
+		main.recorder = &recorder;
+		main.key = 1;
+		main.geometry.client_origin = { 100, 100 };
+		main.geometry.has_frame_rects = true;
+		main.geometry.frame_rect = FRAME_RECT;
+		main.geometry.caption_rect = CAPTION_RECT;
+		main.geometry.has_window_rect = true;
+		main.geometry.window_rect = { 92, 100, 1380, 820 };
+		main.geometry.proposed_client_rect = { 92, 100, 1380, 820 };
+
+		// A button in the caption.
+		main.snapshot.blocking_region = { Rect{ 40, 4, 120, 28 } };
+		main.snapshot.drag_by_content = true;
+		main.snapshot.drag_by_right_click = true;
+
+		// Hit tests before the first snapshot drag nothing.
+		main.hit_test(400, 10);
+
+		main.publish();
+		record_hit_tests(main);
+
+		// The resize border of the default window procedure wins.
+		main.geometry.default_hit_test = HIT_TEST_LEFT;
+		main.hit_test(-2, 300);
+		main.geometry.default_hit_test = HIT_TEST_CLIENT;
+
+		main.snapshot.has_popup = true;
+		main.publish();
+		record_hit_tests(main);
+
+		main.snapshot.has_popup = false;
+		main.snapshot.drag_by_content = false;
+		main.publish();
+		record_hit_tests(main);
+
+		main.snapshot.drag_by_content = true;
+		main.publish();
+		record_right_click_drag(main, false);
+		record_right_click_drag(main, true);
+
+		main.geometry.maximized = true;
+		record_hit_tests(main);
+		main.geometry.maximized = false;
+
+		record_nccalcsize(main);
+		record_keys(main);
+
+		// A sub-window that couldn't query its frame rects.
+		Window popup;
+		popup.recorder = &recorder;
+		popup.key = 2;
+		popup.frame = FRAME_BORDERLESS;
+		popup.geometry.client_origin = { 300, 200 };
+		popup.geometry.proposed_client_rect = { 300, 200, 700, 500 };
+
+		popup.publish();
+		record_hit_tests(popup);
+		record_nccalcsize(popup);
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s <recording>\n", argv[0]);
+		return 1;
+	}
+
+	acrylic::MessageRecorder recorder;
+	if (!recorder.start(argv[1])) {
+		fprintf(stderr, "Failed to create the recording %s.\n", argv[1]);
+		return 1;
+	}
+
+	record_session(recorder);
+
+	if (!recorder.stop()) {
+		fprintf(stderr, "Failed to write the recording %s.\n", argv[1]);
+		return 1;
+	}
+
+	return 0;
+}